@@ -12,14 +12,18 @@
 
 #include <common/atlas.h>
 #include <common/factory.h>
+#include <common/text_cache.h>
 #include <common/types.h>
 
 #include <dmsdk/dlib/hash.h>
 #include <dmsdk/dlib/log.h>
 #include <dmsdk/gamesys/resources/res_textureset.h>
 
+#include <rive/assets/font_asset.hpp>
 #include <rive/assets/image_asset.hpp>
 
+#include <string.h> // strrchr
+
 #if 0
 #define DEBUGLOG(...) dmLogWarning("DEBUG: " __VA_ARGS__)
 #else
@@ -207,6 +211,7 @@ namespace dmRive {
 
     AtlasNameResolver::AtlasNameResolver(HRenderContext context)
     : m_RiveRenderContext(context)
+    , m_TextureBytes(0)
     {
     }
 
@@ -215,23 +220,38 @@ namespace dmRive {
         if (_asset.is<rive::ImageAsset>())
         {
             rive::ImageAsset* asset = _asset.as<rive::ImageAsset>();
-            const std::string& name = asset->name();
-
-            char* name_str     = strdup(name.c_str());
-            char* name_ext_end = strrchr(name_str, '.');
+            DEBUGLOG("Found Asset: %s", asset->name().c_str());
 
-            if (name_ext_end)
+            if (m_RiveRenderContext && GetRendererType() == RENDERER_TYPE_TESSELLATION)
             {
-                name_ext_end[0] = 0;
+                // The tessellation renderer draws the image from the region with the same name in the atlas of the rive scene.
+                // The atlas animation ids have no file extension
+                const std::string& name = asset->name();
+                const char* name_str     = name.c_str();
+                const char* name_ext_end = strrchr(name_str, '.');
+                uint32_t name_length     = name_ext_end ? (uint32_t)(name_ext_end - name_str) : (uint32_t)name.size();
+
+                asset->renderImage(rive::make_rcp<DefoldRenderImage>(dmHashBuffer64(name_str, name_length)));
+                return true;
             }
 
-            DEBUGLOG("Found Asset: %s", name_str);
-            dmhash_t name_hash = dmHashString64(name_str);
-
-            free(name_str);
+            rive::rcp<rive::RenderImage> image = CreateRiveRenderImage(m_RiveRenderContext, (void*) inBandBytes.data(), inBandBytes.size(), &m_Scratch);
+            if (image)
+            {
+                // The images are always uploaded as RGBA8 without mipmaps
+                m_TextureBytes += image->width() * image->height() * 4;
+            }
+            asset->renderImage(image);
 
-            asset->renderImage(CreateRiveRenderImage(m_RiveRenderContext, (void*) inBandBytes.data(), inBandBytes.size()));
+            return true;
+        }
+        else if (_asset.is<rive::FontAsset>() && factory && !inBandBytes.empty())
+        {
+            rive::FontAsset* asset = _asset.as<rive::FontAsset>();
+            DEBUGLOG("Found Font: %s", asset->name().c_str());
 
+            // Share the font (and its shaped text) with other files embedding the same font
+            asset->font(GetCachedFont(factory, inBandBytes));
             return true;
         }
 
@@ -0,0 +1,403 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <common/text_cache.h>
+
+#include <dmsdk/dlib/array.h>
+#include <dmsdk/dlib/hash.h>
+#include <dmsdk/dlib/hashtable.h>
+#include <dmsdk/dlib/math.h>
+#include <dmsdk/dlib/mutex.h>
+
+#include <rive/math/raw_path.hpp>
+
+#include <string.h> // memset
+#include <algorithm> // nth_element
+#include <vector>
+
+namespace dmRive
+{
+    // Max number of shaped strings per font, before the least recently used ones are evicted
+    static const uint32_t MAX_SHAPED_TEXT_COUNT = 256;
+    // Max number of glyph outlines per font, before the least recently used ones are evicted
+    static const uint32_t MAX_GLYPH_COUNT       = 1024;
+    // The part of a full cache that is evicted at once (a quarter)
+    static const uint32_t EVICT_DIVISOR         = 4;
+
+    struct ShapedText
+    {
+        // The decoded fonts used as input. Keeps them alive, so that the font pointers in the key aren't reused.
+        // They're never CachedFonts, so the cache of one font doesn't keep another font alive
+        std::vector<rive::rcp<rive::Font>> m_Fonts;
+        rive::SimpleArray<rive::Paragraph> m_Paragraphs;
+        uint32_t                           m_LastUse;
+    };
+
+    struct CachedGlyph
+    {
+        rive::RawPath                      m_Path;
+        uint32_t                           m_LastUse;
+    };
+
+    // The decoded font and its caches, shared by all the CachedFonts of the same font data (and options).
+    // It's deleted when the last CachedFont using it is, and the count is only changed with the mutex held,
+    // so a font that is being deleted is never handed out
+    struct SharedFont
+    {
+        rive::rcp<rive::Font>              m_Font;
+        dmhash_t                           m_Key;
+        uint32_t                           m_UserCount;
+        uint32_t                           m_UseCount; // Stamps the entries when they're used, see EvictLeastRecentlyUsed()
+        dmHashTable64<ShapedText*>         m_ShapedText;
+        dmHashTable32<CachedGlyph*>        m_Glyphs;
+    };
+
+    static dmMutex::HMutex              g_TextCacheMutex = 0;
+    static dmHashTable64<SharedFont*>   g_Fonts;       // By hash of the font data (and options)
+    static dmHashTable64<SharedFont*>   g_CachedFonts; // By CachedFont address, to find the decoded fonts of the text runs
+    static TextCacheStats               g_Stats;
+
+    template <typename KEY, typename T>
+    static void PutGrow(dmHashTable<KEY, T>& table, KEY key, const T& value)
+    {
+        if (table.Full())
+        {
+            table.OffsetCapacity(dmMath::Max(8u, table.Capacity()));
+        }
+        table.Put(key, value);
+    }
+
+    template <typename KEY>
+    struct LastUse
+    {
+        uint32_t m_LastUse;
+        KEY      m_Key;
+
+        bool operator<(const LastUse& other) const
+        {
+            return m_LastUse < other.m_LastUse;
+        }
+    };
+
+    template <typename KEY, typename T>
+    static void CollectLastUse(std::vector<LastUse<KEY>>* entries, const KEY* key, T** value)
+    {
+        LastUse<KEY> entry = { (*value)->m_LastUse, *key };
+        entries->push_back(entry);
+    }
+
+    // Deletes the least recently used part of the entries, so that a full cache doesn't drop everything in one frame.
+    // Returns the number of deleted entries. Called with the mutex held
+    template <typename KEY, typename T>
+    static uint32_t EvictLeastRecentlyUsed(dmHashTable<KEY, T*>& table)
+    {
+        std::vector<LastUse<KEY>> entries;
+        entries.reserve(table.Size());
+        table.Iterate(CollectLastUse<KEY, T>, &entries);
+        if (entries.empty())
+        {
+            return 0;
+        }
+
+        size_t count = dmMath::Max<size_t>(1, entries.size() / EVICT_DIVISOR);
+        std::nth_element(entries.begin(), entries.begin() + (count - 1), entries.end());
+        for (size_t i = 0; i < count; ++i)
+        {
+            T** value = table.Get(entries[i].m_Key);
+            delete *value;
+            table.Erase(entries[i].m_Key);
+        }
+        return (uint32_t)count;
+    }
+
+    static void DeleteShapedText(void*, const dmhash_t* key, ShapedText** text)
+    {
+        delete *text;
+    }
+
+    static void DeleteGlyph(void*, const uint32_t* key, CachedGlyph** glyph)
+    {
+        delete *glyph;
+    }
+
+    // Called with the mutex held
+    static SharedFont* NewSharedFont(dmhash_t key, rive::rcp<rive::Font> font)
+    {
+        SharedFont* shared = new SharedFont;
+        shared->m_Font      = font;
+        shared->m_Key       = key;
+        shared->m_UserCount = 0;
+        shared->m_UseCount  = 0;
+        PutGrow(g_Fonts, key, shared);
+        g_Stats.m_FontCount++;
+        return shared;
+    }
+
+    // Called with the mutex held
+    static void ReleaseSharedFont(SharedFont* shared)
+    {
+        if (--shared->m_UserCount > 0)
+        {
+            return;
+        }
+
+        g_Fonts.Erase(shared->m_Key);
+        g_Stats.m_FontCount--;
+        g_Stats.m_ShapedTextCount -= shared->m_ShapedText.Size();
+        g_Stats.m_GlyphCount -= shared->m_Glyphs.Size();
+        shared->m_ShapedText.Iterate(DeleteShapedText, (void*)0);
+        shared->m_Glyphs.Iterate(DeleteGlyph, (void*)0);
+        delete shared;
+    }
+
+    static rive::rcp<rive::Font> NewCachedFont(SharedFont* shared);
+
+    // Wraps a font decoded by the factory, and caches the results of the shaping and the glyph outlines.
+    // Each user (e.g. each rive file) gets its own CachedFont, and the caches are shared between them
+    class CachedFont : public rive::Font
+    {
+    public:
+        // Called with the mutex held
+        CachedFont(SharedFont* shared)
+        : rive::Font(shared->m_Font->lineMetrics())
+        , m_Shared(shared)
+        , m_Font(shared->m_Font.get())
+        {
+            shared->m_UserCount++;
+            PutGrow(g_CachedFonts, (uint64_t)(uintptr_t)this, shared);
+        }
+
+        ~CachedFont() override
+        {
+            DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+            g_CachedFonts.Erase((uint64_t)(uintptr_t)this);
+            ReleaseSharedFont(m_Shared);
+        }
+
+        uint16_t getAxisCount() const override                          { return m_Font->getAxisCount(); }
+        Axis getAxis(uint16_t index) const override                     { return m_Font->getAxis(index); }
+        float getAxisValue(uint32_t axisTag) const override             { return m_Font->getAxisValue(axisTag); }
+        rive::SimpleArray<uint32_t> features() const override           { return m_Font->features(); }
+        bool hasGlyph(rive::Span<const rive::Unichar> text) const override { return m_Font->hasGlyph(text); }
+        uint32_t getFeatureValue(uint32_t featureTag) const override    { return m_Font->getFeatureValue(featureTag); }
+
+        // The fonts with variations or features are cached by the options, so that each text style using the same
+        // options shares the shaped text
+        rive::rcp<rive::Font> withOptions(rive::Span<const Coord> variableAxes, rive::Span<const Feature> features) const override
+        {
+            HashState64 state;
+            dmHashInit64(&state, false);
+            dmHashUpdateBuffer64(&state, &m_Shared->m_Key, sizeof(m_Shared->m_Key));
+            dmHashUpdateBuffer64(&state, variableAxes.data(), (uint32_t)(variableAxes.size() * sizeof(Coord)));
+            dmHashUpdateBuffer64(&state, features.data(), (uint32_t)(features.size() * sizeof(Feature)));
+            dmhash_t key = dmHashFinal64(&state);
+
+            {
+                DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+                SharedFont** cached = g_Fonts.Get(key);
+                if (cached)
+                {
+                    return NewCachedFont(*cached);
+                }
+            }
+
+            rive::rcp<rive::Font> font = m_Font->withOptions(variableAxes, features);
+            if (!font)
+            {
+                return nullptr;
+            }
+
+            DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+            SharedFont** cached = g_Fonts.Get(key);
+            return NewCachedFont(cached ? *cached : NewSharedFont(key, font));
+        }
+
+        rive::RawPath getPath(rive::GlyphID glyph) const override
+        {
+            {
+                DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+                CachedGlyph** cached = m_Shared->m_Glyphs.Get(glyph);
+                if (cached)
+                {
+                    (*cached)->m_LastUse = ++m_Shared->m_UseCount;
+                    return (*cached)->m_Path;
+                }
+            }
+
+            CachedGlyph* path = new CachedGlyph;
+            path->m_Path = m_Font->getPath(glyph);
+
+            DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+            if (m_Shared->m_Glyphs.Get(glyph))
+            {
+                // Another thread added the same glyph
+                rive::RawPath result = path->m_Path;
+                delete path;
+                return result;
+            }
+
+            if (m_Shared->m_Glyphs.Size() >= MAX_GLYPH_COUNT)
+            {
+                g_Stats.m_GlyphCount -= EvictLeastRecentlyUsed(m_Shared->m_Glyphs);
+            }
+            path->m_LastUse = ++m_Shared->m_UseCount;
+            PutGrow(m_Shared->m_Glyphs, (uint32_t)glyph, path);
+            g_Stats.m_GlyphCount++;
+            return path->m_Path;
+        }
+
+    protected:
+        rive::SimpleArray<rive::Paragraph> onShapeText(rive::Span<const rive::Unichar> text, rive::Span<const rive::TextRun> runs) const override
+        {
+            // The shaping is done by the decoded fonts, so the CachedFonts in the runs are swapped out for them.
+            // The cached glyph runs reference the decoded fonts, and they're swapped back when the text is returned
+            rive::SimpleArray<rive::TextRun> font_runs(runs.data(), runs.size());
+
+            HashState64 state;
+            dmHashInit64(&state, false);
+            dmHashUpdateBuffer64(&state, text.data(), (uint32_t)(text.size() * sizeof(rive::Unichar)));
+
+            dmhash_t key;
+            {
+                DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+                for (size_t i = 0; i < font_runs.size(); ++i)
+                {
+                    rive::TextRun& run = font_runs[i];
+                    SharedFont** shared = g_CachedFonts.Get((uint64_t)(uintptr_t)run.font.get());
+                    if (shared)
+                        run.font = (*shared)->m_Font;
+
+                    const rive::Font* font = run.font.get();
+                    dmHashUpdateBuffer64(&state, &font, sizeof(font));
+                    dmHashUpdateBuffer64(&state, &run.size, sizeof(run.size));
+                    dmHashUpdateBuffer64(&state, &run.lineHeight, sizeof(run.lineHeight));
+                    dmHashUpdateBuffer64(&state, &run.letterSpacing, sizeof(run.letterSpacing));
+                    dmHashUpdateBuffer64(&state, &run.unicharCount, sizeof(run.unicharCount));
+                    dmHashUpdateBuffer64(&state, &run.script, sizeof(run.script));
+                    dmHashUpdateBuffer64(&state, &run.styleId, sizeof(run.styleId));
+                    dmHashUpdateBuffer64(&state, &run.dir, sizeof(run.dir));
+                }
+                key = dmHashFinal64(&state);
+
+                ShapedText** cached = m_Shared->m_ShapedText.Get(key);
+                if (cached)
+                {
+                    (*cached)->m_LastUse = ++m_Shared->m_UseCount;
+                    return WithCachedFonts((*cached)->m_Paragraphs, runs, font_runs);
+                }
+            }
+
+            // Shape outside of the lock, as it's the expensive part
+            ShapedText* shaped = new ShapedText;
+            shaped->m_Paragraphs = m_Font->shapeText(text, rive::Span<const rive::TextRun>(font_runs.data(), font_runs.size()));
+            shaped->m_Fonts.reserve(font_runs.size());
+            for (size_t i = 0; i < font_runs.size(); ++i)
+            {
+                shaped->m_Fonts.push_back(font_runs[i].font);
+            }
+
+            rive::SimpleArray<rive::Paragraph> result = WithCachedFonts(shaped->m_Paragraphs, runs, font_runs);
+
+            DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+            if (m_Shared->m_ShapedText.Get(key))
+            {
+                // Another thread shaped the same text
+                delete shaped;
+                return result;
+            }
+
+            if (m_Shared->m_ShapedText.Size() >= MAX_SHAPED_TEXT_COUNT)
+            {
+                g_Stats.m_ShapedTextCount -= EvictLeastRecentlyUsed(m_Shared->m_ShapedText);
+            }
+            shaped->m_LastUse = ++m_Shared->m_UseCount;
+            PutGrow(m_Shared->m_ShapedText, key, shaped);
+            g_Stats.m_ShapedTextCount++;
+            return result;
+        }
+
+    private:
+        // Copies the shaped text, with the glyph runs pointing to the fonts of the text runs they were shaped from,
+        // so that the glyph outlines are cached too
+        static rive::SimpleArray<rive::Paragraph> WithCachedFonts(const rive::SimpleArray<rive::Paragraph>& paragraphs, rive::Span<const rive::TextRun> runs, const rive::SimpleArray<rive::TextRun>& font_runs)
+        {
+            rive::SimpleArray<rive::Paragraph> result(paragraphs);
+            for (size_t p = 0; p < result.size(); ++p)
+            {
+                rive::SimpleArray<rive::GlyphRun>& glyph_runs = result[p].runs;
+                for (size_t r = 0; r < glyph_runs.size(); ++r)
+                {
+                    for (size_t i = 0; i < runs.size(); ++i)
+                    {
+                        if (glyph_runs[r].font == font_runs[i].font)
+                        {
+                            glyph_runs[r].font = runs[i].font;
+                            break;
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        SharedFont*                             m_Shared;
+        rive::Font*                             m_Font; // Owned by m_Shared
+    };
+
+    // Called with the mutex held
+    static rive::rcp<rive::Font> NewCachedFont(SharedFont* shared)
+    {
+        return rive::rcp<rive::Font>(new CachedFont(shared));
+    }
+
+    rive::rcp<rive::Font> GetCachedFont(rive::Factory* factory, rive::Span<const uint8_t> font_data)
+    {
+        if (!g_TextCacheMutex)
+        {
+            g_TextCacheMutex = dmMutex::New();
+        }
+
+        dmhash_t data_hash = dmHashBuffer64(font_data.data(), (uint32_t)font_data.size());
+
+        {
+            DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+            SharedFont** cached = g_Fonts.Get(data_hash);
+            if (cached)
+            {
+                return NewCachedFont(*cached);
+            }
+        }
+
+        // Decoded outside of the lock, as it's the expensive part
+        rive::rcp<rive::Font> font = factory->decodeFont(font_data);
+        if (!font)
+        {
+            return nullptr;
+        }
+
+        DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+        // Another thread may have decoded the same font
+        SharedFont** cached = g_Fonts.Get(data_hash);
+        return NewCachedFont(cached ? *cached : NewSharedFont(data_hash, font));
+    }
+
+    void GetTextCacheStats(TextCacheStats* stats)
+    {
+        if (!g_TextCacheMutex)
+        {
+            memset(stats, 0, sizeof(*stats));
+            return;
+        }
+        DM_MUTEX_SCOPED_LOCK(g_TextCacheMutex);
+        *stats = g_Stats;
+    }
+}
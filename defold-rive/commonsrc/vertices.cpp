@@ -65,7 +65,8 @@ void ApplyDrawMode(dmRender::RenderObject& ro, dmRive::DrawMode draw_mode, uint8
     }
 }
 
-void CopyVertices(const dmRive::DrawDescriptor& draw_desc, uint32_t vertex_offset, RiveVertex* out_vertices, uint16_t* out_indices)
+template<typename T>
+static void CopyVerticesT(const dmRive::DrawDescriptor& draw_desc, uint32_t vertex_offset, RiveVertex* out_vertices, T* out_indices)
 {
     uint32_t vertex_count = draw_desc.m_VerticesCount;
     uint32_t tc_count = draw_desc.m_TexCoordsCount;
@@ -99,4 +100,14 @@ void CopyVertices(const dmRive::DrawDescriptor& draw_desc, uint32_t vertex_offse
     }
 }
 
+void CopyVertices(const dmRive::DrawDescriptor& draw_desc, uint32_t vertex_offset, RiveVertex* out_vertices, uint16_t* out_indices)
+{
+    CopyVerticesT(draw_desc, vertex_offset, out_vertices, out_indices);
+}
+
+void CopyVertices(const dmRive::DrawDescriptor& draw_desc, uint32_t vertex_offset, RiveVertex* out_vertices, uint32_t* out_indices)
+{
+    CopyVerticesT(draw_desc, vertex_offset, out_vertices, out_indices);
+}
+
 } // namespace
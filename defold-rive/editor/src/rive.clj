@@ -95,7 +95,8 @@
         default-animation :default-animation
         default-state-machine :default-state-machine
         blend-mode :blend-mode
-        create-go-bones :create-go-bones))))
+        create-go-bones :create-go-bones
+        bake-animations :bake-animations))))
 
 (g/defnk produce-transform [position rotation scale]
   (math/->mat4-non-uniform (Vector3d. (double-array position))
@@ -667,7 +668,7 @@
 ; .rivemodel (The "instance" file)
 ;
 
-(g/defnk produce-rivemodel-save-value [rive-scene-resource artboard default-animation default-state-machine material-resource blend-mode create-go-bones]
+(g/defnk produce-rivemodel-save-value [rive-scene-resource artboard default-animation default-state-machine material-resource blend-mode create-go-bones bake-animations]
   (protobuf/make-map-without-defaults rive-model-pb-class
     :scene (resource/resource->proj-path rive-scene-resource)
     :material (resource/resource->proj-path material-resource)
@@ -675,7 +676,8 @@
     :default-animation default-animation
     :default-state-machine default-state-machine
     :blend-mode blend-mode
-    :create-go-bones create-go-bones))
+    :create-go-bones create-go-bones
+    :bake-animations bake-animations))
 
 (defn- validate-model-artboard [node-id rive-scene rive-artboards artboard]
   (when (and rive-scene (not-empty artboard))
@@ -787,6 +789,7 @@
                                   (validate-model-default-animation _node-id rive-scene rive-anim-ids default-animation)))
             (dynamic edit-type (g/fnk [rive-anim-ids] (properties/->choicebox (cons "" rive-anim-ids)))))
   (property create-go-bones g/Bool (default (protobuf/default rive-model-pb-class :create-go-bones)))
+  (property bake-animations g/Bool (default (protobuf/default rive-model-pb-class :bake-animations)))
 
   (input dep-build-targets g/Any :array)
   (input rive-file-handle g/Any)
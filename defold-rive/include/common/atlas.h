@@ -14,6 +14,7 @@
 #define DM_RIVE_ATLAS_H
 
 #include <stdint.h>
+#include <dmsdk/dlib/array.h>
 #include <dmsdk/dlib/hash.h>
 #include <dmsdk/dlib/hashtable.h>
 
@@ -50,8 +51,13 @@ namespace dmRive {
 
         bool loadContents(rive::FileAsset& asset, rive::Span<const uint8_t> inBandBytes, rive::Factory* factory);
 
+        // The number of bytes used by the textures created while loading the file
+        uint32_t GetTextureBytes() const { return m_TextureBytes; }
+
     private:
-        HRenderContext m_RiveRenderContext;
+        HRenderContext    m_RiveRenderContext;
+        dmArray<uint8_t>  m_Scratch; // Reused for the pixel conversions of all images in the file
+        uint32_t          m_TextureBytes;
     };
 
     Atlas*      CreateAtlas(const dmGameSystemDDF::TextureSet* texture_set_ddf);
@@ -0,0 +1,39 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef DM_RIVE_TEXT_CACHE_H
+#define DM_RIVE_TEXT_CACHE_H
+
+#include <stdint.h>
+
+#include <rive/factory.hpp>
+#include <rive/span.hpp>
+#include <rive/text_engine.hpp>
+
+namespace dmRive
+{
+    // Returns a font that caches the shaped text and the glyph outlines. The decoded font and the caches are shared
+    // between all the rive files using the same font data, and are deleted when the last of the fonts is.
+    // Returns a null font if the factory couldn't decode the font data.
+    rive::rcp<rive::Font> GetCachedFont(rive::Factory* factory, rive::Span<const uint8_t> font_data);
+
+    struct TextCacheStats
+    {
+        uint32_t m_FontCount;
+        uint32_t m_ShapedTextCount;
+        uint32_t m_GlyphCount;
+    };
+
+    void GetTextCacheStats(TextCacheStats* stats);
+}
+
+#endif // DM_RIVE_TEXT_CACHE_H
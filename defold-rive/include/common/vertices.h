@@ -42,6 +42,8 @@ namespace dmRive
     void ApplyDrawMode(dmRender::RenderObject& ro, dmRive::DrawMode draw_mode, uint8_t clipIndex);
 
     void CopyVertices(const dmRive::DrawDescriptor& draw_desc, uint32_t vertex_offset, RiveVertex* out_vertices, uint16_t* out_indices);
+    // For buffers holding more than 64k vertices
+    void CopyVertices(const dmRive::DrawDescriptor& draw_desc, uint32_t vertex_offset, RiveVertex* out_vertices, uint32_t* out_indices);
 
     // Used by both editor and runtime
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -231,6 +231,20 @@ namespace dmGraphics
 
     void     RepackRGBToRGBA(uint32_t num_pixels, uint8_t* rgb, uint8_t* rgba);
     HContext GetInstalledContext();
+
+    float GetDisplayScaleFactor(HContext context);
+
+    enum AdapterFamily
+    {
+        ADAPTER_FAMILY_NONE   = -1,
+        ADAPTER_FAMILY_NULL   = 1,
+        ADAPTER_FAMILY_OPENGL = 2,
+        ADAPTER_FAMILY_VULKAN = 3,
+        ADAPTER_FAMILY_VENDOR = 4,
+        ADAPTER_FAMILY_WEBGPU = 5,
+    };
+
+    AdapterFamily GetInstalledAdapterFamily();
 }
 
 #endif
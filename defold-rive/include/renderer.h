@@ -16,6 +16,7 @@
 #define DM_RIVE_RENDERER_H
 
 #include <memory>
+#include <dmsdk/dlib/array.h>
 #include <dmsdk/resource/resource.h>
 #include <dmsdk/graphics/graphics.h>
 #include <dmsdk/render/render.h>
@@ -35,20 +36,41 @@ namespace dmRive
     typedef void*  HRenderContext;
     typedef struct ShaderResources ShaderResources;
 
+    enum RendererType
+    {
+        RENDERER_TYPE_DEFAULT,      // The pixel local storage renderer of the platform, drawing into offscreen targets
+        RENDERER_TYPE_TESSELLATION, // Triangulates the paths, which are drawn as regular render objects
+    };
+
+    // Must be set before the first context is created. The tessellation renderer is always used with the null graphics adapter
+    void                         SetRendererType(RendererType type);
+    // The type of the renderer in use, once the first context has been created
+    RendererType                 GetRendererType();
+
+    // Each context has its own offscreen targets and frame state. The GPU resources are shared between the contexts
     HRenderContext               NewRenderContext();
     void                         DeleteRenderContext(HRenderContext context);
-    rive::rcp<rive::RenderImage> CreateRiveRenderImage(HRenderContext context, void* bytes, uint32_t byte_count);
+    // The scratch buffer is used for pixel conversions, and can be shared between calls to avoid reallocations
+    rive::rcp<rive::RenderImage> CreateRiveRenderImage(HRenderContext context, void* bytes, uint32_t byte_count, dmArray<uint8_t>* scratch);
     rive::Factory*               GetRiveFactory(HRenderContext context);
     rive::Renderer*              GetRiveRenderer(HRenderContext context);
     rive::Mat2D                  GetViewTransform(HRenderContext context, dmRender::HRenderContext render_context);
     rive::Mat2D                  GetViewProjectionTransform(HRenderContext context, dmRender::HRenderContext render_context);
     void                         GetDimensions(HRenderContext context, uint32_t* width, uint32_t* height);
-    void                         RenderBegin(HRenderContext context, dmResource::HFactory factory);
+    // Begins a frame in one of the offscreen targets. Each target has its own backing texture,
+    // so that several frames can be composited at different places in the same render list
+    void                         RenderBegin(HRenderContext context, dmResource::HFactory factory, uint32_t target_index);
     void                         RenderEnd(HRenderContext context);
+    // By default, the pipeline state changed by Rive is restored after each frame. When disabled, the render script
+    // must set the states it uses (blend, cull, depth, stencil and color mask) before drawing after the Rive models
+    void                         SetRestorePipelineState(bool restore);
+    // Where the linked GPU programs are cached between launches. Must be set before the first context is created
+    void                         SetProgramCachePath(const char* path);
     dmResource::Result           LoadShaders(dmResource::HFactory factory, ShaderResources** resources);
     void                         ReleaseShaders(dmResource::HFactory factory, ShaderResources** resources);
 
     dmRender::HMaterial          GetBlitToBackBufferMaterial(HRenderContext context, dmRender::HRenderContext render_context);
+    // The backing texture of the target of the current (or last) frame
     dmGraphics::HTexture         GetBackingTexture(HRenderContext context);
 }
 
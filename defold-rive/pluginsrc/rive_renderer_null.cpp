@@ -5,8 +5,13 @@
 
 namespace dmRive
 {
-	rive::rcp<rive::RenderImage> CreateRiveRenderImage(HRenderContext context, void* bytes, uint32_t byte_count)
+	rive::rcp<rive::RenderImage> CreateRiveRenderImage(HRenderContext context, void* bytes, uint32_t byte_count, dmArray<uint8_t>* scratch)
     {
     	return nullptr;
     }
+
+    RendererType GetRendererType()
+    {
+        return RENDERER_TYPE_TESSELLATION;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,236 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#if !defined(DM_RIVE_UNSUPPORTED)
+
+#include "baked_animation.h"
+
+#include <float.h>
+#include <math.h>
+
+#include <dmsdk/dlib/math.h>
+
+#include <rive/artboard.hpp>
+#include <rive/animation/keyed_object.hpp>
+#include <rive/animation/keyed_property.hpp>
+#include <rive/animation/linear_animation.hpp>
+#include <rive/core/field_types/core_double_type.hpp>
+#include <rive/generated/core_registry.hpp>
+
+namespace dmRive
+{
+    static const float    DEFAULT_SAMPLE_RATE = 60.0f;
+    static const uint32_t MAX_FRAME_COUNT     = 60 * 60;   // Longer animations aren't worth keeping in memory
+    static const float    QUANTIZE_MAX        = 65535.0f;
+    static const uint32_t APPLY_BATCH_SIZE    = 64;
+    static const float    STEP_TOLERANCE      = 1.0f / 1024.0f; // Relative to the change between two samples
+
+    static bool IsBakeable(const rive::LinearAnimation* animation, const std::vector<rive::Core*>& objects, uint32_t* track_count)
+    {
+        uint32_t count = 0;
+        for (size_t i = 0; i < animation->numKeyedObjects(); ++i)
+        {
+            const rive::KeyedObject* keyed_object = animation->getObject(i);
+            if (keyed_object->objectId() >= objects.size() || objects[keyed_object->objectId()] == 0)
+                return false;
+
+            for (size_t p = 0; p < keyed_object->numKeyedProperties(); ++p)
+            {
+                uint32_t key = keyed_object->getProperty(p)->propertyKey();
+                if (rive::CoreRegistry::isCallback(key) || rive::CoreRegistry::propertyFieldId(key) != rive::CoreDoubleType::id)
+                    return false;
+                ++count;
+            }
+        }
+        *track_count = count;
+        return count > 0;
+    }
+
+    BakedAnimation* BakeAnimation(rive::ArtboardInstance* artboard, const rive::LinearAnimation* animation)
+    {
+        const std::vector<rive::Core*>& objects = artboard->objects();
+
+        uint32_t track_count;
+        if (!IsBakeable(animation, objects, &track_count))
+        {
+            return 0;
+        }
+
+        float sample_rate = animation->fps() > 0 ? (float)animation->fps() : DEFAULT_SAMPLE_RATE;
+        uint32_t frame_count = (uint32_t)ceilf(animation->durationSeconds() * sample_rate) + 1;
+        if (frame_count > MAX_FRAME_COUNT)
+        {
+            return 0;
+        }
+
+        float start_time = animation->startSeconds();
+        float end_time   = animation->endSeconds();
+
+        dmArray<uint32_t> object_ids;
+        dmArray<uint16_t> property_keys;
+        object_ids.SetCapacity(track_count);
+        property_keys.SetCapacity(track_count);
+        for (size_t i = 0; i < animation->numKeyedObjects(); ++i)
+        {
+            const rive::KeyedObject* keyed_object = animation->getObject(i);
+            for (size_t p = 0; p < keyed_object->numKeyedProperties(); ++p)
+            {
+                object_ids.Push(keyed_object->objectId());
+                property_keys.Push((uint16_t)keyed_object->getProperty(p)->propertyKey());
+            }
+        }
+
+        // Sample the values using the keyframe interpolators, [frame * track_count + track]
+        dmArray<float> values;
+        values.SetCapacity(frame_count * track_count);
+        values.SetSize(frame_count * track_count);
+        for (uint32_t f = 0; f < frame_count; ++f)
+        {
+            float time = dmMath::Min(start_time + f / sample_rate, end_time);
+            animation->apply(artboard, time, 1.0f);
+
+            float* row = &values[f * track_count];
+            for (uint32_t t = 0; t < track_count; ++t)
+            {
+                row[t] = rive::CoreRegistry::getDouble(objects[object_ids[t]], property_keys[t]);
+            }
+        }
+
+        BakedAnimation* baked = new BakedAnimation;
+        baked->m_TrackCount = track_count;
+        baked->m_FrameCount = frame_count;
+        baked->m_StartTime  = start_time;
+        baked->m_SampleRate = sample_rate;
+
+        // The keyframes aren't exposed by the runtime, so the hold keyframes are found by sampling halfway between the samples:
+        // a value that changes between two samples, but is (almost) equal to one of them halfway, jumps somewhere in between.
+        // An interpolated value is halfway there, or at least clearly away from both samples
+        baked->m_StepOffsets.SetCapacity(frame_count + 1);
+        for (uint32_t f = 0; f < frame_count; ++f)
+        {
+            baked->m_StepOffsets.Push(baked->m_StepTracks.Size());
+            if (f + 1 == frame_count)
+                continue;
+
+            float time = dmMath::Min(start_time + (f + 0.5f) / sample_rate, end_time);
+            animation->apply(artboard, time, 1.0f);
+
+            const float* row0 = &values[f * track_count];
+            const float* row1 = &values[(f + 1) * track_count];
+            for (uint32_t t = 0; t < track_count; ++t)
+            {
+                float a = row0[t];
+                float b = row1[t];
+                if (a == b)
+                    continue;
+
+                float mid = rive::CoreRegistry::getDouble(objects[object_ids[t]], property_keys[t]);
+                float tolerance = fabsf(b - a) * STEP_TOLERANCE;
+                if (fabsf(mid - a) <= tolerance || fabsf(mid - b) <= tolerance)
+                {
+                    if (baked->m_StepTracks.Full())
+                        baked->m_StepTracks.OffsetCapacity(dmMath::Max(16u, baked->m_StepTracks.Capacity()));
+                    baked->m_StepTracks.Push(t);
+                }
+            }
+        }
+        baked->m_StepOffsets.Push(baked->m_StepTracks.Size());
+
+        baked->m_ObjectIds.Swap(object_ids);
+        baked->m_PropertyKeys.Swap(property_keys);
+
+        // Quantize each track to its own range
+        baked->m_Min.SetCapacity(track_count);
+        baked->m_Min.SetSize(track_count);
+        baked->m_Scale.SetCapacity(track_count);
+        baked->m_Scale.SetSize(track_count);
+        for (uint32_t t = 0; t < track_count; ++t)
+        {
+            float min = FLT_MAX;
+            float max = -FLT_MAX;
+            for (uint32_t f = 0; f < frame_count; ++f)
+            {
+                min = dmMath::Min(min, values[f * track_count + t]);
+                max = dmMath::Max(max, values[f * track_count + t]);
+            }
+            baked->m_Min[t]   = min;
+            baked->m_Scale[t] = (max - min) / QUANTIZE_MAX;
+        }
+
+        baked->m_Samples.SetCapacity(frame_count * track_count);
+        baked->m_Samples.SetSize(frame_count * track_count);
+        for (uint32_t i = 0; i < frame_count * track_count; ++i)
+        {
+            uint32_t t = i % track_count;
+            float scale = baked->m_Scale[t];
+            float q = scale > 0.0f ? (values[i] - baked->m_Min[t]) / scale : 0.0f;
+            baked->m_Samples[i] = (uint16_t)dmMath::Clamp(q + 0.5f, 0.0f, QUANTIZE_MAX);
+        }
+
+        return baked;
+    }
+
+    void DeleteBakedAnimation(BakedAnimation* baked)
+    {
+        delete baked;
+    }
+
+    void ApplyBakedAnimation(const BakedAnimation* baked, rive::Artboard* artboard, float time)
+    {
+        float frame = dmMath::Clamp((time - baked->m_StartTime) * baked->m_SampleRate, 0.0f, (float)(baked->m_FrameCount - 1));
+        uint32_t frame0 = (uint32_t)frame;
+        uint32_t frame1 = dmMath::Min(frame0 + 1, baked->m_FrameCount - 1);
+        float t = frame - frame0;
+
+        const uint32_t track_count = baked->m_TrackCount;
+        const uint16_t* row0       = baked->m_Samples.Begin() + frame0 * track_count;
+        const uint16_t* row1       = baked->m_Samples.Begin() + frame1 * track_count;
+        const float* mins          = baked->m_Min.Begin();
+        const float* scales        = baked->m_Scale.Begin();
+        const uint32_t* object_ids = baked->m_ObjectIds.Begin();
+        const uint16_t* keys       = baked->m_PropertyKeys.Begin();
+        const uint32_t* steps      = baked->m_StepTracks.Begin();
+        const uint32_t step_begin  = baked->m_StepOffsets[frame0];
+        const uint32_t step_end    = baked->m_StepOffsets[frame0 + 1];
+
+        const std::vector<rive::Core*>& objects = artboard->objects();
+
+        // The values are computed in batches in a tight loop over the two contiguous rows that the compiler can vectorize.
+        // The tracks that jump between the two samples then get the value of the first one, before all are written to the objects
+        float values[APPLY_BATCH_SIZE];
+        uint32_t step = step_begin;
+        for (uint32_t base = 0; base < track_count; base += APPLY_BATCH_SIZE)
+        {
+            uint32_t count = dmMath::Min(APPLY_BATCH_SIZE, track_count - base);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                float a = row0[base + i];
+                float b = row1[base + i];
+                values[i] = mins[base + i] + (a + (b - a) * t) * scales[base + i];
+            }
+
+            // The step tracks are sorted
+            for (; step < step_end && steps[step] < base + count; ++step)
+            {
+                uint32_t track = steps[step];
+                values[track - base] = mins[track] + row0[track] * scales[track];
+            }
+
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                rive::CoreRegistry::setDouble(objects[object_ids[base + i]], keys[base + i], values[i]);
+            }
+        }
+    }
+}
+
+#endif // DM_RIVE_UNSUPPORTED
@@ -0,0 +1,56 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef DM_RIVE_BAKED_ANIMATION_H
+#define DM_RIVE_BAKED_ANIMATION_H
+
+#include <stdint.h>
+#include <dmsdk/dlib/array.h>
+
+namespace rive
+{
+    class Artboard;
+    class ArtboardInstance;
+    class LinearAnimation;
+}
+
+namespace dmRive
+{
+    // A linear animation sampled at a fixed rate into quantized tracks.
+    // The samples of a frame are contiguous, so that applying the animation interpolates between two rows of samples.
+    // The values jump instead between the samples where the track has a hold keyframe
+    struct BakedAnimation
+    {
+        dmArray<uint32_t>   m_ObjectIds;    // Per track: index of the keyed object in the artboard
+        dmArray<uint16_t>   m_PropertyKeys; // Per track: the keyed property
+        dmArray<float>      m_Min;          // Per track: value = m_Min + sample * m_Scale
+        dmArray<float>      m_Scale;
+        dmArray<uint16_t>   m_Samples;      // [frame * track_count + track]
+        dmArray<uint32_t>   m_StepOffsets;  // Per frame: the first of its entries in m_StepTracks. One more than the frame count
+        dmArray<uint32_t>   m_StepTracks;   // The tracks that jump between each frame and the next one
+        uint32_t            m_TrackCount;
+        uint32_t            m_FrameCount;
+        float               m_StartTime;
+        float               m_SampleRate;
+    };
+
+    // Samples the animation using the artboard, which must be an unused instance of the artboard owning the animation.
+    // Returns 0 if the animation keys anything else than numbers, or reports events, in which case the animation
+    // has to be applied using the keyframe interpolators
+    BakedAnimation* BakeAnimation(rive::ArtboardInstance* artboard, const rive::LinearAnimation* animation);
+    void            DeleteBakedAnimation(BakedAnimation* baked);
+
+    // Applies the animation at the time (in seconds), as LinearAnimation::apply() with a mix of 1
+    void            ApplyBakedAnimation(const BakedAnimation* baked, rive::Artboard* artboard, float time);
+}
+
+#endif // DM_RIVE_BAKED_ANIMATION_H
@@ -0,0 +1,91 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "block_pool.h"
+
+#include <stdlib.h> // malloc
+
+#include <dmsdk/dlib/math.h>
+
+namespace dmRive
+{
+    // Enough for any of the types stored in the pools
+    static const uint32_t BLOCK_ALIGNMENT = 16;
+
+    void BlockPoolInit(BlockPool* pool, uint32_t block_size, uint32_t blocks_per_page)
+    {
+        block_size = dmMath::Max(block_size, (uint32_t)sizeof(void*));
+
+        pool->m_FreeList      = 0;
+        pool->m_BlockSize     = (block_size + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+        pool->m_BlocksPerPage = blocks_per_page;
+        pool->m_UsedCount     = 0;
+    }
+
+    void BlockPoolDestroy(BlockPool* pool)
+    {
+        for (uint32_t i = 0; i < pool->m_Pages.Size(); ++i)
+        {
+            free(pool->m_Pages[i]);
+        }
+        pool->m_Pages.SetCapacity(0);
+        pool->m_FreeList  = 0;
+        pool->m_UsedCount = 0;
+    }
+
+    void* BlockPoolAlloc(BlockPool* pool)
+    {
+        if (!pool->m_FreeList)
+        {
+            uint8_t* page = (uint8_t*)malloc(pool->m_BlockSize * pool->m_BlocksPerPage);
+            if (!page)
+            {
+                return 0;
+            }
+            if (pool->m_Pages.Full())
+            {
+                pool->m_Pages.OffsetCapacity(4);
+            }
+            pool->m_Pages.Push(page);
+
+            // Linked in reverse, so that the blocks are handed out in address order
+            for (uint32_t i = pool->m_BlocksPerPage; i > 0; --i)
+            {
+                void* block = page + (i - 1) * pool->m_BlockSize;
+                *(void**)block = pool->m_FreeList;
+                pool->m_FreeList = block;
+            }
+        }
+
+        void* block = pool->m_FreeList;
+        pool->m_FreeList = *(void**)block;
+        pool->m_UsedCount++;
+        return block;
+    }
+
+    void BlockPoolFree(BlockPool* pool, void* block)
+    {
+        *(void**)block = pool->m_FreeList;
+        pool->m_FreeList = block;
+        pool->m_UsedCount--;
+    }
+
+    uint32_t BlockPoolGetReservedBytes(const BlockPool* pool)
+    {
+        return pool->m_Pages.Size() * pool->m_BlocksPerPage * pool->m_BlockSize;
+    }
+
+    uint32_t BlockPoolGetUsedBytes(const BlockPool* pool)
+    {
+        return pool->m_UsedCount * pool->m_BlockSize;
+    }
+}
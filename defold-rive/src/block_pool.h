@@ -0,0 +1,44 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef DM_RIVE_BLOCK_POOL_H
+#define DM_RIVE_BLOCK_POOL_H
+
+#include <stdint.h>
+#include <dmsdk/dlib/array.h>
+
+namespace dmRive
+{
+    // Fixed size blocks, allocated in pages.
+    // The freed blocks are reused, and the pages are only released when the pool is destroyed
+    struct BlockPool
+    {
+        dmArray<uint8_t*>   m_Pages;
+        void*               m_FreeList;     // Each free block stores a pointer to the next free block
+        uint32_t            m_BlockSize;
+        uint32_t            m_BlocksPerPage;
+        uint32_t            m_UsedCount;
+    };
+
+    void     BlockPoolInit(BlockPool* pool, uint32_t block_size, uint32_t blocks_per_page);
+    // Frees all pages at once. Any objects still in the pool must already be destructed
+    void     BlockPoolDestroy(BlockPool* pool);
+
+    // Returns 0 if a new page couldn't be allocated
+    void*    BlockPoolAlloc(BlockPool* pool);
+    void     BlockPoolFree(BlockPool* pool, void* block);
+
+    uint32_t BlockPoolGetReservedBytes(const BlockPool* pool);
+    uint32_t BlockPoolGetUsedBytes(const BlockPool* pool);
+}
+
+#endif // DM_RIVE_BLOCK_POOL_H
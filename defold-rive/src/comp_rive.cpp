@@ -12,6 +12,10 @@
 
 #if !defined(DM_RIVE_UNSUPPORTED)
 
+#include <float.h> // FLT_MAX
+#include <math.h> // NAN
+#include <new>
+#include <stdlib.h> // malloc
 #include <string.h> // memset
 
 // rive-cpp
@@ -30,17 +34,23 @@
 #include <rive/custom_property_string.hpp>
 #include <rive/file.hpp>
 #include <rive/renderer.hpp>
+#include <rive/text/text_value_run.hpp>
+#include <rive/viewmodel/viewmodel_instance.hpp>
 
 // Rive extension
 #include "comp_rive.h"
 #include "res_rive_data.h"
 #include "res_rive_scene.h"
 #include "res_rive_model.h"
+#include "baked_animation.h"
+#include "worker_pool.h"
+#include "component_pool.h"
 
 #include <common/bones.h>
 #include <common/vertices.h>
 #include <common/factory.h>
 #include <common/tess_renderer.h>
+#include <common/text_cache.h>
 
 // Defold Rive Renderer
 #include "renderer.h"
@@ -51,7 +61,6 @@
 #include <dmsdk/script.h>
 #include <dmsdk/dlib/log.h>
 #include <dmsdk/dlib/math.h>
-#include <dmsdk/dlib/object_pool.h>
 #include <dmsdk/dlib/profile.h>
 #include <dmsdk/gameobject/component.h>
 #include <dmsdk/gameobject/gameobject.h>
@@ -66,6 +75,7 @@
 #include <dmsdk/gamesys/resources/res_meshset.h>
 #include <dmsdk/gamesys/resources/res_animationset.h>
 #include <dmsdk/gamesys/resources/res_textureset.h>
+#include <dmsdk/gamesys/resources/res_texture.h>
 
 // Not in dmSDK yet
 namespace dmScript
@@ -77,23 +87,15 @@ namespace dmScript
 DM_PROPERTY_GROUP(rmtp_Rive, "Rive");
 DM_PROPERTY_U32(rmtp_RiveBones, 0, FrameReset, "# rive bones", &rmtp_Rive);
 DM_PROPERTY_U32(rmtp_RiveComponents, 0, FrameReset, "# rive components", &rmtp_Rive);
-
-namespace dmGraphics
-{
-    float GetDisplayScaleFactor(HContext context);
-
-    enum AdapterFamily
-    {
-        ADAPTER_FAMILY_NONE   = -1,
-        ADAPTER_FAMILY_NULL   = 1,
-        ADAPTER_FAMILY_OPENGL = 2,
-        ADAPTER_FAMILY_VULKAN = 3,
-        ADAPTER_FAMILY_VENDOR = 4,
-        ADAPTER_FAMILY_WEBGPU = 5,
-    };
-
-    AdapterFamily GetInstalledAdapterFamily();
-}
+DM_PROPERTY_U32(rmtp_RiveInstances, 0, FrameReset, "# rive artboard instances", &rmtp_Rive);
+DM_PROPERTY_U32(rmtp_RiveArtboardBytesEstimate, 0, FrameReset, "estimated bytes used by rive artboard instances (not measured)", &rmtp_Rive);
+DM_PROPERTY_U32(rmtp_RiveTextureBytes, 0, FrameReset, "bytes used by rive textures", &rmtp_Rive);
+DM_PROPERTY_U32(rmtp_RivePoolBytes, 0, FrameReset, "bytes reserved by the rive world pools", &rmtp_Rive);
+DM_PROPERTY_U32(rmtp_RivePoolUsedBytes, 0, FrameReset, "bytes used in the rive world pools", &rmtp_Rive);
+DM_PROPERTY_U32(rmtp_RiveFonts, 0, FrameReset, "# rive fonts", &rmtp_Rive);
+DM_PROPERTY_U32(rmtp_RiveShapedText, 0, FrameReset, "# cached shaped texts", &rmtp_Rive);
+DM_PROPERTY_U32(rmtp_RiveGlyphs, 0, FrameReset, "# cached glyph outlines", &rmtp_Rive);
+DM_PROPERTY_U32(rmtp_RiveFlushes, 0, FrameReset, "# rive flushes", &rmtp_Rive);
 
 namespace dmRender
 {
@@ -110,6 +112,8 @@ namespace dmRive
     static const dmhash_t PROP_MATERIAL           = dmHashString64("material");
     static const dmhash_t MATERIAL_EXT_HASH       = dmHashString64("materialc");
 
+    static const uint32_t MAX_ANIMATION_LAYER_COUNT = 4; // Max number of animations being faded out
+
     static float g_DisplayFactor = 1.0f;
 
     static void ResourceReloadedCallback(const dmResource::ResourceReloadedParams* params);
@@ -118,6 +122,10 @@ namespace dmRive
     static bool CreateBones(struct RiveWorld* world, RiveComponent* component);
     static void DeleteBones(RiveComponent* component);
     static void UpdateBones(RiveComponent* component);
+    static void ResolveBoneAttachments(RiveComponent* component);
+    static void UpdateBoneAttachments(struct RiveComponentHot* hot);
+    static void FlushPointerEvents(struct RiveComponentHot* hot);
+    static void WaitForAdvance(RiveWorld* world);
 
     // For the entire app's life cycle
     struct CompRiveContext
@@ -131,29 +139,154 @@ namespace dmRive
         dmGraphics::HContext     m_GraphicsContext;
         dmGraphics::HTexture     m_NullTexture;
         uint32_t                 m_MaxInstanceCount;
+        float                    m_FixedTimestep;   // Default fixed timestep for new worlds. 0 means variable timestep
+        uint32_t                 m_MaxSubsteps;
+        HWorkerPool              m_WorkerPool;
+        uint8_t                  m_PipelinedUpdate : 1; // Advance the components on the worker threads, after they have been drawn
+    };
+
+    // The per component data that the update and render loops touch every frame.
+    // It's stored densely, and points to the rest of the component data (which doesn't move).
+    // The entries move when components are created or destroyed, so pointers to them must not be kept
+    // across anything that may run Lua code (e.g. the callbacks run by HandleAdvanceResults())
+    struct RiveComponentHot
+    {
+        dmVMath::Matrix4                        m_World;
+        dmTransform::Transform                  m_Transform;
+        dmGameObject::HInstance                 m_Instance;
+        RiveComponent*                          m_Component;
+        uint32_t                                m_MixedHash;
+        uint8_t                                 m_Enabled : 1;
+        uint8_t                                 m_DoRender : 1;
+        uint8_t                                 m_AddedToUpdate : 1;
+        uint8_t                                 m_ReHash : 1;
+    };
+
+    // A component that can receive pointer events, see UpdatePointerIndex()
+    struct RivePointerTarget
+    {
+        dmVMath::Matrix4                        m_WorldInverse;
+        float                                   m_MinX, m_MinY, m_MaxX, m_MaxY; // The artboard bounds, in pointer space
+        RiveComponent*                          m_Component;
+    };
+
+    static const uint32_t MAX_POINTER_GRID_SIZE = 32; // Max number of cells along each axis
+    static const uint32_t MAX_POINTER_EVENT_COUNT = 64; // Max number of queued pointer events per component
+    static const uint32_t MAX_RENDER_GROUP_COUNT = 8; // Max number of offscreen targets per render list
+    static const uint32_t PREWARM_SAMPLE_COUNT = 4; // Number of times each animation is drawn when prewarming
+
+    // The components are allocated in chunks, so that their addresses stay valid when the world grows
+    static const uint32_t COMPONENT_CHUNK_SIZE = 16;
+
+    struct RiveComponentChunk
+    {
+        RiveComponent*                          m_Components; // COMPONENT_CHUNK_SIZE slots
+        uint32_t                                m_UsedCount;
+        uint32_t                                m_Index;      // In m_ComponentChunks
+    };
+
+    struct RiveFreeComponent
+    {
+        RiveComponent*                          m_Component;
+        RiveComponentChunk*                     m_Chunk;
+    };
+
+    // A range of the tessellated triangles, uploaded into its own buffers. With 16 bit indices, a new range is started
+    // when the vertices wouldn't fit, as the render objects can't offset the indices into the vertex buffer
+    struct RiveTessBuffer
+    {
+        dmGraphics::HVertexBuffer               m_VertexBuffer;
+        dmGraphics::HIndexBuffer                m_IndexBuffer;
+        uint32_t                                m_VertexStart; // Into m_TessVertices
+        uint32_t                                m_IndexStart;  // Into m_TessIndices, or m_TessIndices16
     };
 
     // One per collection
     struct RiveWorld
     {
         CompRiveContext*                        m_Ctx;
-        HRenderContext                          m_RiveRenderContext;
-        dmObjectPool<RiveComponent*>            m_Components;
-        dmArray<dmRender::RenderObject>         m_RenderObjects;
-        dmArray<dmRender::HNamedConstantBuffer> m_RenderConstants; // 1:1 mapping with the render objects
+        HRenderContext                          m_RiveRenderContext; // The offscreen targets of this world. Shares the GPU resources with the other worlds
+        ComponentPool<RiveComponentHot>         m_Components;       // Grows on demand, and shrinks when mostly unused
+        dmArray<RiveComponentChunk*>            m_ComponentChunks;  // Referenced by the components, see RiveComponent::m_Chunk
+        dmArray<RiveFreeComponent>              m_FreeComponents;   // Unused slots in the chunks
+        BlockPool                               m_AnimationInstancePool;
+        BlockPool                               m_StateMachineInstancePool;
+        dmArray<dmRender::RenderObject*>        m_RenderObjects;    // One blit per render group (or one per draw call with the tessellation renderer). Allocated on demand, as they must stay valid until the render list is drawn
+        uint32_t                                m_RenderObjectCount; // Number of render objects used in the current render list, with the tessellation renderer
+        dmArray<dmRender::HNamedConstantBuffer> m_TessConstants;    // The constants of m_RenderObjects, with the tessellation renderer
+        dmArray<RiveVertex>                     m_TessVertices;     // The triangles of the current render list, with the tessellation renderer
+        dmArray<uint32_t>                       m_TessIndices;
+        dmArray<uint16_t>                       m_TessIndices16;    // Used instead of m_TessIndices when 32 bit indices aren't supported
+        dmArray<RiveTessBuffer>                 m_TessBuffers;      // Allocated on demand, as they must stay valid until the render list is drawn
+        uint32_t                                m_TessBufferCount;  // Number of buffers used in the current render list
+        uint32_t*                               m_RenderGroupEnd;   // The end of the last batch in the open render group, or 0
+        uint32_t                                m_RenderGroupCount; // Number of render groups in the current render list
+        dmArray<RivePointerTarget>              m_PointerTargets;
+        dmArray<uint32_t>                       m_PointerCells;      // Per grid cell, the start in m_PointerCellItems. Followed by the total count
+        dmArray<uint32_t>                       m_PointerCellItems;  // Indices into m_PointerTargets
+        dmArray<RiveComponent*>                 m_PointerHovered;    // The components the last pointer move was sent to
+        dmArray<RiveComponent*>                 m_PointerHoveredNext;
+        float                                   m_PointerGridMinX;
+        float                                   m_PointerGridMinY;
+        float                                   m_PointerCellWidth;
+        float                                   m_PointerCellHeight;
+        uint32_t                                m_PointerGridSize;
         dmGraphics::HVertexBuffer               m_BlitToBackbufferVertexBuffer;
+        double                                  m_TimeAccumulator; // Time not yet advanced, in fixed timestep mode
+        float                                   m_FixedTimestep;
+        uint32_t                                m_MaxSubsteps;
+        float                                   m_TimeScale;
+        uint32_t                                m_InstanceCount;   // Stats from the last update
+        uint32_t                                m_InstanceBytes;   // Estimated, see EstimateArtboardInstanceBytes()
+        uint32_t                                m_PointerEventCount;    // Number of pointer events queued in the components
+        uint32_t                                m_BoneAttachmentCount;  // Number of game objects following bones in the components
+        WorkerJob                               m_AdvanceJob;
+        dmArray<RiveComponent*>                 m_AdvanceComponents; // The components to advance in the pipelined mode
+        float                                   m_AdvanceDt;
+        uint32_t                                m_AdvanceStepCount;
+        uint32_t                                m_DispatchCount;        // Number of render list dispatches drawing the world this frame
+        uint32_t                                m_LastDispatchCount;    // Number of dispatches in the previous frame. The advance is started after the last one
+        uint8_t                                 m_AdvancePending : 1;  // The advance is waiting for the components to be drawn
+        uint8_t                                 m_AdvanceRunning : 1;  // The advance has been started on the worker threads
+        uint8_t                                 m_ComponentsAdded : 1; // Components were added to the update since the last update
+        uint8_t                                 m_PointerIndexDirty : 1; // The transforms or the components have changed since the pointer index was built
+        uint8_t                                 m_Tessellation : 1;      // The paths are tessellated on the CPU and drawn with the material of the components, see RenderBatchTess()
+        uint8_t                                 m_TessIndices32 : 1;     // The graphics adapter supports 32 bit indices
     };
 
+    static dmArray<RiveWorld*> g_Worlds; // All worlds, so that the advances can be waited for when the rive data is reloaded
+
     dmGameObject::CreateResult CompRiveNewWorld(const dmGameObject::ComponentNewWorldParams& params)
     {
         CompRiveContext* context = (CompRiveContext*)params.m_Context;
         RiveWorld* world         = new RiveWorld();
 
         world->m_Ctx = context;
-        world->m_Components.SetCapacity(context->m_MaxInstanceCount);
-        world->m_RenderObjects.SetCapacity(context->m_MaxInstanceCount);
-        world->m_RenderConstants.SetCapacity(context->m_MaxInstanceCount);
-        world->m_RenderConstants.SetSize(context->m_MaxInstanceCount);
+        world->m_RiveRenderContext = NewRenderContext();
+        world->m_Tessellation = GetRendererType() == RENDERER_TYPE_TESSELLATION;
+        world->m_RenderObjectCount = 0;
+        world->m_TessBufferCount = 0;
+        world->m_TessIndices32 = dmGraphics::IsIndexBufferFormatSupported(context->m_GraphicsContext, dmGraphics::INDEXBUFFER_FORMAT_32);
+        // The component storage is allocated when the first components are created
+        world->m_RenderGroupEnd = 0;
+        world->m_RenderGroupCount = 0;
+        BlockPoolInit(&world->m_AnimationInstancePool, sizeof(rive::LinearAnimationInstance), 32);
+        BlockPoolInit(&world->m_StateMachineInstancePool, sizeof(rive::StateMachineInstance), 8);
+        world->m_TimeAccumulator = 0.0;
+        world->m_FixedTimestep   = context->m_FixedTimestep;
+        world->m_MaxSubsteps     = context->m_MaxSubsteps;
+        world->m_TimeScale       = 1.0f;
+        world->m_InstanceCount   = 0;
+        world->m_InstanceBytes   = 0;
+        world->m_PointerEventCount   = 0;
+        world->m_BoneAttachmentCount = 0;
+        world->m_ComponentsAdded = 0;
+        world->m_AdvancePending  = 0;
+        world->m_AdvanceRunning  = 0;
+        world->m_DispatchCount   = 0;
+        world->m_LastDispatchCount = 1;
+        world->m_PointerIndexDirty = 1;
+        world->m_PointerGridSize = 0;
 
         float bottom = 0.0f;
         float top    = 1.0f;
@@ -176,10 +309,12 @@ namespace dmRive
 
         world->m_BlitToBackbufferVertexBuffer = dmGraphics::NewVertexBuffer(context->m_GraphicsContext, sizeof(vertex_data), (void*) vertex_data, dmGraphics::BUFFER_USAGE_STATIC_DRAW);
 
-        memset(world->m_RenderConstants.Begin(), 0, sizeof(dmGameSystem::HComponentRenderConstants)*world->m_RenderConstants.Capacity());
-
         *params.m_World = world;
 
+        if (g_Worlds.Full())
+            g_Worlds.OffsetCapacity(4);
+        g_Worlds.Push(world);
+
         dmResource::RegisterResourceReloadedCallback(context->m_Factory, ResourceReloadedCallback, world);
 
         return dmGameObject::CREATE_RESULT_OK;
@@ -188,11 +323,42 @@ namespace dmRive
     dmGameObject::CreateResult CompRiveDeleteWorld(const dmGameObject::ComponentDeleteWorldParams& params)
     {
         RiveWorld* world = (RiveWorld*)params.m_World;
+        WaitForAdvance(world);
+
+        for (uint32_t i = 0; i < g_Worlds.Size(); ++i)
+        {
+            if (g_Worlds[i] == world)
+            {
+                g_Worlds.EraseSwap(i);
+                break;
+            }
+        }
 
         dmGraphics::DeleteVertexBuffer(world->m_BlitToBackbufferVertexBuffer);
+        for (uint32_t i = 0; i < world->m_TessBuffers.Size(); ++i)
+        {
+            dmGraphics::DeleteVertexBuffer(world->m_TessBuffers[i].m_VertexBuffer);
+            dmGraphics::DeleteIndexBuffer(world->m_TessBuffers[i].m_IndexBuffer);
+        }
+        DeleteRenderContext(world->m_RiveRenderContext);
 
         dmResource::UnregisterResourceReloadedCallback(((CompRiveContext*)params.m_Context)->m_Factory, ResourceReloadedCallback, world);
 
+        for (uint32_t i = 0; i < world->m_ComponentChunks.Size(); ++i)
+        {
+            free(world->m_ComponentChunks[i]->m_Components);
+            delete world->m_ComponentChunks[i];
+        }
+        for (uint32_t i = 0; i < world->m_RenderObjects.Size(); ++i)
+        {
+            delete world->m_RenderObjects[i];
+        }
+        for (uint32_t i = 0; i < world->m_TessConstants.Size(); ++i)
+        {
+            dmRender::DeleteNamedConstantBuffer(world->m_TessConstants[i]);
+        }
+        BlockPoolDestroy(&world->m_AnimationInstancePool);
+        BlockPoolDestroy(&world->m_StateMachineInstancePool);
         delete world;
         return dmGameObject::CREATE_RESULT_OK;
     }
@@ -201,8 +367,9 @@ namespace dmRive
         return component->m_Material ? component->m_Material : resource->m_Material->m_Material;
     }
 
-    static void ReHash(RiveComponent* component)
+    static void ReHash(RiveComponentHot* hot)
     {
+        RiveComponent* component = hot->m_Component;
         // material, texture set, blend mode and render constants
         HashState32 state;
         bool reverse = false;
@@ -215,52 +382,169 @@ namespace dmRive
         dmHashUpdateBuffer32(&state, &ddf->m_BlendMode, sizeof(ddf->m_BlendMode));
         if (texture_set)
             dmHashUpdateBuffer32(&state, &texture_set, sizeof(texture_set));
-        component->m_MixedHash = dmHashFinal32(&state);
-        component->m_ReHash = 0;
+        hot->m_MixedHash = dmHashFinal32(&state);
+        hot->m_ReHash = 0;
     }
 
     static inline RiveComponent* GetComponentFromIndex(RiveWorld* world, int index)
     {
-        return world->m_Components.Get(index);
+        return world->m_Components.Get(index).m_Component;
     }
 
-    void* CompRiveGetComponent(const dmGameObject::ComponentGetParams& params)
+    static inline RiveComponentHot* GetHot(RiveComponent* component)
     {
-        RiveWorld* world = (RiveWorld*)params.m_World;
-        uint32_t index = (uint32_t)(uintptr_t)params.m_UserData;
-        return GetComponentFromIndex(world, index);
+        return &component->m_RiveWorld->m_Components.Get(component->m_Index);
     }
 
-    dmGameObject::CreateResult CompRiveCreate(const dmGameObject::ComponentCreateParams& params)
+    // The instances are created from the world pools (rather than with ArtboardInstance::animationAt() and
+    // stateMachineAt()) so that playing animations over and over doesn't fragment the heap
+    static RiveAnimationInstancePtr NewAnimationInstance(RiveComponent* component, uint32_t index)
     {
-        RiveWorld* world = (RiveWorld*)params.m_World;
+        BlockPool* pool = &component->m_RiveWorld->m_AnimationInstancePool;
+        rive::ArtboardInstance* artboard = component->m_ArtboardInstance.get();
+        rive::LinearAnimation* animation = artboard->animation(index);
+        if (!animation)
+        {
+            return RiveAnimationInstancePtr(nullptr, RivePoolDeleter{pool});
+        }
+        void* block = BlockPoolAlloc(pool);
+        if (!block)
+        {
+            dmLogError("Could not allocate an animation instance");
+            return RiveAnimationInstancePtr(nullptr, RivePoolDeleter{pool});
+        }
+        return RiveAnimationInstancePtr(new (block) rive::LinearAnimationInstance(animation, artboard), RivePoolDeleter{pool});
+    }
 
-        if (world->m_Components.Full())
+    static RiveStateMachineInstancePtr NewStateMachineInstance(RiveComponent* component, uint32_t index)
+    {
+        BlockPool* pool = &component->m_RiveWorld->m_StateMachineInstancePool;
+        rive::ArtboardInstance* artboard = component->m_ArtboardInstance.get();
+        rive::StateMachine* state_machine = artboard->stateMachine(index);
+        if (!state_machine)
         {
-            dmLogError("Rive instance could not be created since the buffer is full (%d).", world->m_Components.Capacity());
-            return dmGameObject::CREATE_RESULT_UNKNOWN_ERROR;
+            return RiveStateMachineInstancePtr(nullptr, RivePoolDeleter{pool});
+        }
+        void* block = BlockPoolAlloc(pool);
+        if (!block)
+        {
+            dmLogError("Could not allocate a state machine instance");
+            return RiveStateMachineInstancePtr(nullptr, RivePoolDeleter{pool});
         }
+        return RiveStateMachineInstancePtr(new (block) rive::StateMachineInstance(state_machine, artboard), RivePoolDeleter{pool});
+    }
 
-        RiveComponent* component = new RiveComponent;
-        memset(component, 0, sizeof(RiveComponent));
+    static void DeleteAnimationInstance(RiveComponent* component, rive::LinearAnimationInstance* instance)
+    {
+        RivePoolDeleter deleter = { &component->m_RiveWorld->m_AnimationInstancePool };
+        deleter(instance);
+    }
 
-        uint32_t index = world->m_Components.Alloc();
-        world->m_Components.Set(index, component);
-        component->m_Instance = params.m_Instance;
-        component->m_Transform = dmTransform::Transform(Vector3(params.m_Position), params.m_Rotation, 1.0f);
-        component->m_Resource = (RiveModelResource*)params.m_Resource;
+    // Returns uninitialized memory for a component, and the chunk to store in RiveComponent::m_Chunk.
+    // Returns 0 if a new chunk couldn't be allocated
+    static RiveComponent* AllocComponent(RiveWorld* world, RiveComponentChunk** out_chunk)
+    {
+        if (world->m_FreeComponents.Empty())
+        {
+            RiveComponent* components = (RiveComponent*)malloc(sizeof(RiveComponent) * COMPONENT_CHUNK_SIZE);
+            if (!components)
+            {
+                return 0;
+            }
 
-        CompRiveAnimationReset(component);
-        dmMessage::ResetURL(&component->m_Listener);
+            RiveComponentChunk* chunk = new RiveComponentChunk;
+            chunk->m_Components = components;
+            chunk->m_UsedCount  = 0;
+            chunk->m_Index      = world->m_ComponentChunks.Size();
 
-        component->m_ComponentIndex = params.m_ComponentIndex;
-        component->m_Enabled = 1;
-        component->m_World = Matrix4::identity();
-        component->m_DoRender = 0;
-        component->m_RenderConstants = 0;
+            if (world->m_ComponentChunks.Full())
+                world->m_ComponentChunks.OffsetCapacity(dmMath::Max(4u, world->m_ComponentChunks.Capacity()));
+            world->m_ComponentChunks.Push(chunk);
+
+            // Room for all slots, so that pushing a freed component never reallocates
+            uint32_t slot_count = world->m_ComponentChunks.Size() * COMPONENT_CHUNK_SIZE;
+            if (world->m_FreeComponents.Capacity() < slot_count)
+                world->m_FreeComponents.SetCapacity(dmMath::Max(slot_count, world->m_FreeComponents.Capacity() * 2));
+            for (uint32_t i = 0; i < COMPONENT_CHUNK_SIZE; ++i)
+            {
+                // Reversed, so that the components are allocated from the start of the chunk
+                RiveFreeComponent slot = { &chunk->m_Components[COMPONENT_CHUNK_SIZE - 1 - i], chunk };
+                world->m_FreeComponents.Push(slot);
+            }
+        }
+
+        RiveFreeComponent slot = world->m_FreeComponents.Back();
+        world->m_FreeComponents.Pop();
+        slot.m_Chunk->m_UsedCount++;
+        *out_chunk = slot.m_Chunk;
+        return slot.m_Component;
+    }
+
+    // The component must already be destructed
+    static void FreeComponent(RiveWorld* world, RiveComponentChunk* chunk, RiveComponent* component)
+    {
+        RiveFreeComponent free_slot = { component, chunk };
+        world->m_FreeComponents.Push(free_slot);
+
+        // Release empty chunks, but keep a chunk worth of spare slots, so that creating
+        // and deleting a component over and over doesn't allocate each time
+        if (--chunk->m_UsedCount != 0 || world->m_FreeComponents.Size() < COMPONENT_CHUNK_SIZE * 2)
+        {
+            return;
+        }
+
+        for (uint32_t i = world->m_FreeComponents.Size(); i > 0; --i)
+        {
+            if (world->m_FreeComponents[i - 1].m_Chunk == chunk)
+            {
+                world->m_FreeComponents.EraseSwap(i - 1);
+            }
+        }
+        free(chunk->m_Components);
+        uint32_t chunk_index = chunk->m_Index;
+        delete chunk;
+        world->m_ComponentChunks.EraseSwap(chunk_index);
+        if (chunk_index < world->m_ComponentChunks.Size())
+            world->m_ComponentChunks[chunk_index]->m_Index = chunk_index;
+
+        uint32_t slot_count = world->m_ComponentChunks.Size() * COMPONENT_CHUNK_SIZE;
+        if (world->m_FreeComponents.Capacity() > 4 * slot_count && slot_count > 0)
+            world->m_FreeComponents.SetCapacity(2 * slot_count);
+    }
+
+    void* CompRiveGetComponent(const dmGameObject::ComponentGetParams& params)
+    {
+        RiveWorld* world = (RiveWorld*)params.m_World;
+        WaitForAdvance(world); // The script may access the artboard
+        uint32_t index = (uint32_t)(uintptr_t)params.m_UserData;
+        return GetComponentFromIndex(world, index);
+    }
+
+    static void ClearAnimationLayers(RiveComponent* component)
+    {
+        for (uint32_t i = 0; i < component->m_AnimationLayers.Size(); ++i)
+        {
+            DeleteAnimationInstance(component, component->m_AnimationLayers[i].m_Instance);
+        }
+        component->m_AnimationLayers.SetSize(0);
+    }
 
+    static void CreateArtboardInstance(RiveComponent* component)
+    {
         dmRive::RiveSceneData* data = (dmRive::RiveSceneData*) component->m_Resource->m_Scene->m_Scene;
 
+        RiveWorld* world = component->m_RiveWorld;
+        if (component->m_ArtboardInstance)
+        {
+            world->m_InstanceCount--;
+            world->m_InstanceBytes -= component->m_InstanceBytes;
+        }
+
+        component->m_File = data->m_File;
+        component->m_ArtboardInstance.reset();
+        component->m_ViewModelInstance.reset();
+        component->m_ViewModelProperties.Clear();
+
         if (component->m_Resource->m_DDF->m_Artboard)
         {
             component->m_ArtboardInstance = data->m_File->artboardNamed(component->m_Resource->m_DDF->m_Artboard);
@@ -275,8 +559,70 @@ namespace dmRive
         {
             component->m_ArtboardInstance = data->m_File->artboardDefault();
         }
+
+        // Bind the default view model instance, so that the data bindings can be driven from script
+        component->m_ViewModelInstance.reset(data->m_File->createViewModelInstance(component->m_ArtboardInstance.get()));
+        if (component->m_ViewModelInstance)
+        {
+            component->m_ArtboardInstance->dataContextFromInstance(component->m_ViewModelInstance.get());
+        }
+
         component->m_ArtboardInstance->advance(0.0f);
 
+        // Keep the stats up to date here, so that the update doesn't have to visit every component to count them.
+        // The artboard may not be the default one, so the estimate is made from the instance itself
+        component->m_InstanceBytes = EstimateArtboardInstanceBytes(component->m_ArtboardInstance.get());
+        world->m_InstanceCount++;
+        world->m_InstanceBytes += component->m_InstanceBytes;
+    }
+
+    dmGameObject::CreateResult CompRiveCreate(const dmGameObject::ComponentCreateParams& params)
+    {
+        RiveWorld* world = (RiveWorld*)params.m_World;
+        WaitForAdvance(world);
+
+        if (world->m_Components.Size() == world->m_Ctx->m_MaxInstanceCount)
+        {
+            // Only a hint, the storage grows as needed
+            dmLogWarning("The number of Rive instances in the collection exceeds rive.max_instance_count (%d)", world->m_Ctx->m_MaxInstanceCount);
+        }
+
+        RiveComponentChunk* chunk;
+        void* storage = AllocComponent(world, &chunk);
+        if (!storage)
+        {
+            dmLogError("Could not allocate a Rive component");
+            return dmGameObject::CREATE_RESULT_UNKNOWN_ERROR;
+        }
+
+        RiveComponent* component = new (storage) RiveComponent;
+        memset(component, 0, sizeof(RiveComponent));
+        component->m_Chunk = chunk;
+
+        RiveComponentHot hot;
+        memset(&hot, 0, sizeof(hot));
+        hot.m_Component = component;
+        hot.m_Instance  = params.m_Instance;
+        hot.m_Transform = dmTransform::Transform(Vector3(params.m_Position), params.m_Rotation, 1.0f);
+        hot.m_World     = Matrix4::identity();
+        hot.m_Enabled   = 1;
+        hot.m_ReHash    = 1;
+
+        // The hot data is referenced by index, so it may move when the pool grows
+        uint32_t index = world->m_Components.Alloc(hot);
+        component->m_Instance = params.m_Instance;
+        component->m_RiveWorld = world;
+        component->m_Index = index;
+        component->m_Resource = (RiveModelResource*)params.m_Resource;
+
+        CompRiveAnimationReset(component);
+        dmMessage::ResetURL(&component->m_Listener);
+
+        component->m_ComponentIndex = params.m_ComponentIndex;
+        component->m_RenderConstants = 0;
+
+        CreateArtboardInstance(component);
+
         if (component->m_Resource->m_CreateGoBones)
         {
             dmRive::GetAllBones(component->m_ArtboardInstance.get(), &component->m_Bones);
@@ -296,6 +642,7 @@ namespace dmRive
             ddf.m_Offset            = 0.0;
             ddf.m_PlaybackRate      = 1.0;
             ddf.m_IsStateMachine    = true;
+            ddf.m_CrossfadeTime     = 0.0f;
             if (!CompRivePlayStateMachine(component, &ddf, 0))
             {
                 dmLogError("Couldn't play state machine named '%s'", dmHashReverseSafe64(state_machine_id));
@@ -309,14 +656,13 @@ namespace dmRive
             ddf.m_Offset            = 0.0;
             ddf.m_PlaybackRate      = 1.0;
             ddf.m_IsStateMachine    = false;
+            ddf.m_CrossfadeTime     = 0.0f;
             if (!CompRivePlayAnimation(component, &ddf, 0))
             {
                 dmLogError("Couldn't play animation named '%s'", dmHashReverseSafe64(anim_id));
             }
         }
 
-        component->m_ReHash = 1;
-
         *params.m_UserData = (uintptr_t)index;
         return dmGameObject::CREATE_RESULT_OK;
     }
@@ -364,18 +710,44 @@ namespace dmRive
         if (component->m_RenderConstants)
             dmGameSystem::DestroyRenderConstants(component->m_RenderConstants);
 
-        component->m_ArtboardInstance.reset();
+        ClearAnimationLayers(component);
         component->m_AnimationInstance.reset();
         component->m_StateMachineInstance.reset();
 
-        delete component;
-        world->m_Components.Free(index, true);
+        if (component->m_ArtboardInstance)
+        {
+            world->m_InstanceCount--;
+            world->m_InstanceBytes -= component->m_InstanceBytes;
+        }
+        // The data context of the artboard references the view model instance
+        component->m_ArtboardInstance.reset();
+        component->m_ViewModelInstance.reset();
+        component->m_ViewModelProperties.Clear();
+
+        world->m_PointerEventCount -= component->m_PointerEvents.Size();
+        world->m_BoneAttachmentCount -= component->m_BoneAttachments.Size();
+
+        RiveComponentChunk* chunk = component->m_Chunk;
+        component->~RiveComponent();
+        FreeComponent(world, chunk, component);
+        world->m_Components.Free(index);
+
+        world->m_PointerIndexDirty = 1;
+        for (uint32_t i = 0; i < world->m_PointerHovered.Size(); ++i)
+        {
+            if (world->m_PointerHovered[i] == component)
+            {
+                world->m_PointerHovered.EraseSwap(i);
+                break;
+            }
+        }
     }
 
     dmGameObject::CreateResult CompRiveDestroy(const dmGameObject::ComponentDestroyParams& params)
     {
         CompRiveContext* ctx = (CompRiveContext*)params.m_Context;
         RiveWorld* world = (RiveWorld*)params.m_World;
+        WaitForAdvance(world);
         uint32_t index = *params.m_UserData;
         RiveComponent* component = GetComponentFromIndex(world, index);
         if (component->m_Material) {
@@ -419,145 +791,422 @@ namespace dmRive
         }
     }
 
-    static void RenderBatchEnd(RiveWorld* world, dmRender::HRenderContext render_context)
+    // The components are drawn into an offscreen target, which is composited with a blit.
+    // Batches that are next to each other in the render order share a group (one flush and one blit).
+    // When other content is drawn between two batches, a new group with its own target is started,
+    // so that the Rive content is composited at the right place in the render order.
+    static void BeginRenderGroup(RiveWorld* world, dmRender::HRenderContext render_context)
+    {
+        uint32_t index = world->m_RenderGroupCount++;
+        RenderBegin(world->m_RiveRenderContext, world->m_Ctx->m_Factory, index);
+
+        if (index >= world->m_RenderObjects.Size())
+        {
+            if (world->m_RenderObjects.Full())
+                world->m_RenderObjects.OffsetCapacity(1);
+            world->m_RenderObjects.Push(new dmRender::RenderObject);
+        }
+
+        // Do our own resolve here. The render objects are drawn after the dispatch, when the group has been flushed
+        dmRender::RenderObject& ro = *world->m_RenderObjects[index];
+        ro.Init();
+        ro.m_Material          = GetBlitToBackBufferMaterial(world->m_RiveRenderContext, render_context);
+        ro.m_VertexDeclaration = dmRender::GetVertexDeclaration(ro.m_Material);
+        ro.m_VertexBuffer      = world->m_BlitToBackbufferVertexBuffer;
+        ro.m_PrimitiveType     = dmGraphics::PRIMITIVE_TRIANGLES;
+        ro.m_VertexStart       = 0;
+        ro.m_VertexCount       = 6;
+        ro.m_Textures[0]       = GetBackingTexture(world->m_RiveRenderContext);
+        dmRender::AddToRender(render_context, &ro);
+    }
+
+    static void EndRenderGroup(RiveWorld* world)
     {
-        if (world->m_RiveRenderContext)
+        if (world->m_RenderGroupEnd)
         {
             RenderEnd(world->m_RiveRenderContext);
+            world->m_RenderGroupEnd = 0;
+            DM_PROPERTY_ADD_U32(rmtp_RiveFlushes, 1);
+        }
+    }
 
-            // Do our own resolve here
-            dmRender::RenderObject& ro = *world->m_RenderObjects.End();
-            world->m_RenderObjects.SetSize(world->m_RenderObjects.Size()+1);
-            ro.Init();
-            ro.m_Material          = GetBlitToBackBufferMaterial(world->m_RiveRenderContext, render_context);
-            ro.m_VertexDeclaration = dmRender::GetVertexDeclaration(ro.m_Material);
-            ro.m_VertexBuffer      = world->m_BlitToBackbufferVertexBuffer;
-            ro.m_PrimitiveType     = dmGraphics::PRIMITIVE_TRIANGLES;
-            ro.m_VertexStart       = 0;
-            ro.m_VertexCount       = 6;
-            ro.m_Textures[0]       = GetBackingTexture(world->m_RiveRenderContext);
-            dmRender::AddToRender(render_context, &ro);
+    static void DrawInstance(rive::Renderer* renderer, RiveComponent* c)
+    {
+        if (c->m_StateMachineInstance) {
+            c->m_StateMachineInstance->draw(renderer);
+        } else if (c->m_AnimationInstance) {
+            c->m_AnimationInstance->draw(renderer);
+        } else {
+            c->m_ArtboardInstance->draw(renderer);
         }
     }
 
-    static void RenderBatch(RiveWorld* world, dmRender::HRenderContext render_context, dmRender::RenderListEntry *buf, uint32_t* begin, uint32_t* end)
+    static void DrawComponent(rive::Renderer* renderer, RiveComponentHot* hot, const rive::Mat2D& view_transform)
     {
-        RiveComponent*              first    = (RiveComponent*) buf[*begin].m_UserData;
-        dmRive::RiveSceneResource* scene_res = first->m_Resource->m_Scene;
-        dmRive::RiveSceneData* data          = (dmRive::RiveSceneData*) scene_res->m_Scene;
-        world->m_RiveRenderContext           = data->m_RiveRenderContext;
+        RiveComponent* c = hot->m_Component;
 
-        RenderBegin(world->m_RiveRenderContext, world->m_Ctx->m_Factory);
+        rive::Mat2D transform;
+        Mat4ToMat2D(hot->m_World, transform);
 
-        uint32_t width, height;
-        GetDimensions(world->m_RiveRenderContext, &width, &height);
+        rive::AABB bounds = c->m_ArtboardInstance->bounds();
 
-        rive::Mat2D viewTransform = GetViewTransform(world->m_RiveRenderContext, render_context);
-        rive::Renderer* renderer = GetRiveRenderer(world->m_RiveRenderContext);
+        renderer->save();
+
+        // Rive is using a different coordinate system than defold,
+        // we have to adhere to how our projection matrixes are
+        // constructed so we flip the renderer on the y axis here
+        rive::Vec2D yflip(g_DisplayFactor, -g_DisplayFactor);
+        transform = transform.scale(yflip);
+
+        renderer->transform(view_transform * transform);
+
+        renderer->align(rive::Fit::none,
+            rive::Alignment::center,
+            rive::AABB(-bounds.width(), bounds.height(), bounds.width(), -bounds.height()),
+            bounds);
+
+        DrawInstance(renderer, c);
+
+        renderer->restore();
+    }
+
+    static dmRender::RenderObject* NewTessRenderObject(RiveWorld* world)
+    {
+        uint32_t index = world->m_RenderObjectCount++;
+        if (index >= world->m_RenderObjects.Size())
+        {
+            if (world->m_RenderObjects.Full())
+                world->m_RenderObjects.OffsetCapacity(dmMath::Max(16u, world->m_RenderObjects.Capacity()));
+            if (world->m_TessConstants.Full())
+                world->m_TessConstants.OffsetCapacity(dmMath::Max(16u, world->m_TessConstants.Capacity()));
+            world->m_RenderObjects.Push(new dmRender::RenderObject);
+            world->m_TessConstants.Push(dmRender::NewNamedConstantBuffer());
+        }
+
+        dmRender::RenderObject* ro = world->m_RenderObjects[index];
+        ro->Init();
+        ro->m_ConstantBuffer = world->m_TessConstants[index];
+        return ro;
+    }
+
+    template<typename T>
+    static T* AllocTessData(dmArray<T>& array, uint32_t count)
+    {
+        uint32_t offset = array.Size();
+        if (array.Remaining() < count)
+            array.OffsetCapacity(dmMath::Max(count, array.Capacity()));
+        array.SetSize(offset + count);
+        return array.Begin() + offset;
+    }
 
-        uint32_t window_height = dmGraphics::GetWindowHeight(world->m_Ctx->m_GraphicsContext);
+    static const uint32_t MAX_TESS_VERTICES_16 = 65535; // Max number of vertices per buffer with 16 bit indices. 0xffff is left out, as it may restart the primitive
+
+    // Returns the buffers to add the vertices to, starting new ones when they don't fit.
+    // Returns 0 if there are too many vertices to be drawn with 16 bit indices
+    static RiveTessBuffer* GetTessBuffer(RiveWorld* world, uint32_t vertex_count)
+    {
+        uint32_t vertex_start = world->m_TessVertices.Size();
+        if (world->m_TessBufferCount > 0)
+        {
+            RiveTessBuffer* buffer = &world->m_TessBuffers[world->m_TessBufferCount - 1];
+            if (world->m_TessIndices32 || vertex_start - buffer->m_VertexStart + vertex_count <= MAX_TESS_VERTICES_16)
+                return buffer;
+        }
+
+        if (!world->m_TessIndices32 && vertex_count > MAX_TESS_VERTICES_16)
+            return 0;
+
+        uint32_t index = world->m_TessBufferCount++;
+        if (index >= world->m_TessBuffers.Size())
+        {
+            if (world->m_TessBuffers.Full())
+                world->m_TessBuffers.OffsetCapacity(4);
+            RiveTessBuffer buffer;
+            buffer.m_VertexBuffer = dmGraphics::NewVertexBuffer(world->m_Ctx->m_GraphicsContext, 0, 0, dmGraphics::BUFFER_USAGE_DYNAMIC_DRAW);
+            buffer.m_IndexBuffer = dmGraphics::NewIndexBuffer(world->m_Ctx->m_GraphicsContext, 0, 0, dmGraphics::BUFFER_USAGE_DYNAMIC_DRAW);
+            world->m_TessBuffers.Push(buffer);
+        }
+
+        RiveTessBuffer* buffer = &world->m_TessBuffers[index];
+        buffer->m_VertexStart = vertex_start;
+        buffer->m_IndexStart = world->m_TessIndices32 ? world->m_TessIndices.Size() : world->m_TessIndices16.Size();
+        return buffer;
+    }
+
+    // With the tessellation renderer (see SetRendererType()), the paths are turned into triangles on the CPU.
+    // Each draw call becomes a render object using the material of the component, drawn directly into the render target.
+    // The triangles of the whole render list are uploaded at the end of the dispatch
+    static void RenderBatchTess(RiveWorld* world, dmRender::HRenderContext render_context, dmRender::RenderListEntry *buf, uint32_t* begin, uint32_t* end)
+    {
+        DefoldTessRenderer* renderer = (DefoldTessRenderer*) GetRiveRenderer(world->m_RiveRenderContext);
+
+        // Follows the order of the values set below
+        static const dmhash_t constant_names[4] = {UNIFORM_PROPERTIES, UNIFORM_GRADIENT_LIMITS, UNIFORM_COLOR, UNIFORM_STOPS};
 
         for (uint32_t *i=begin;i!=end;i++)
         {
-            RiveComponent* c = (RiveComponent*) buf[*i].m_UserData;
+            RiveComponentHot* hot = (RiveComponentHot*) buf[*i].m_UserData;
 
-            if (!c->m_Enabled || !c->m_AddedToUpdate)
+            if (!hot->m_Enabled || !hot->m_AddedToUpdate)
                 continue;
 
-            rive::Mat2D transform;
-            Mat4ToMat2D(c->m_World, transform);
+            RiveComponent* c = hot->m_Component;
+            RiveModelResource* resource = c->m_Resource;
 
-            rive::AABB bounds = c->m_ArtboardInstance->bounds();
+            renderer->reset();
+            renderer->SetAtlas(resource->m_Scene->m_Atlas);
 
-            renderer->save();
+            rive::Mat2D transform;
+            Mat4ToMat2D(hot->m_World, transform);
 
-            // Rive is using a different coordinate system than defold,
-            // we have to adhere to how our projection matrixes are
-            // constructed so we flip the renderer on the y axis here
-            rive::Vec2D yflip(g_DisplayFactor, -g_DisplayFactor);
+            // The projection of the render script is used, so only the y axis is flipped here (see DrawComponent())
+            rive::Vec2D yflip(1.0f, -1.0f);
             transform = transform.scale(yflip);
 
-            renderer->transform(viewTransform * transform);
+            rive::AABB bounds = c->m_ArtboardInstance->bounds();
 
+            renderer->save();
+            renderer->transform(transform);
             renderer->align(rive::Fit::none,
                 rive::Alignment::center,
                 rive::AABB(-bounds.width(), bounds.height(), bounds.width(), -bounds.height()),
                 bounds);
-
-            if (c->m_StateMachineInstance) {
-                c->m_StateMachineInstance->draw(renderer);
-            } else if (c->m_AnimationInstance) {
-                c->m_AnimationInstance->draw(renderer);
-            } else {
-                c->m_ArtboardInstance->draw(renderer);
-            }
-
+            DrawInstance(renderer, c);
             renderer->restore();
-        }
-    }
 
-    void UpdateTransforms(RiveWorld* world)
-    {
-        DM_PROFILE("UpdateTransforms");
+            DrawDescriptor* descriptors;
+            uint32_t descriptor_count;
+            renderer->getDrawDescriptors(&descriptors, &descriptor_count);
+            if (descriptor_count == 0)
+                continue;
 
-        dmArray<RiveComponent*>& components = world->m_Components.GetRawObjects();
-        uint32_t n = components.Size();
-        for (uint32_t i = 0; i < n; ++i)
-        {
-            RiveComponent* c = components[i];
+            dmRender::HMaterial material = GetMaterial(c, resource);
+            dmGraphics::HVertexDeclaration vertex_declaration = dmRender::GetVertexDeclaration(material);
+            dmGameSystem::TextureSetResource* texture_set = resource->m_Scene->m_TextureSet;
+            dmGraphics::HTexture texture = texture_set ? texture_set->m_Texture->m_Texture : world->m_Ctx->m_NullTexture;
 
-            if (!c->m_Enabled || !c->m_AddedToUpdate)
-                continue;
+            dmGraphics::BlendFactor src_factor, dst_factor;
+            GetBlendFactorsFromBlendMode(resource->m_DDF->m_BlendMode, &src_factor, &dst_factor);
 
-            const Matrix4& go_world = dmGameObject::GetWorldMatrix(c->m_Instance);
-            const Matrix4 local = dmTransform::ToMatrix4(c->m_Transform);
-            // if (dmGameObject::ScaleAlongZ(c->m_Instance))
-            // {
-            //     c->m_World = go_world * local;
-            // }
-            // else
+            for (uint32_t d = 0; d < descriptor_count; ++d)
             {
-                c->m_World = dmTransform::MulNoScaleZ(go_world, local);
+                const DrawDescriptor& desc = descriptors[d];
+
+                RiveTessBuffer* buffer = GetTessBuffer(world, desc.m_VerticesCount);
+                if (!buffer)
+                {
+                    dmLogOnceWarning("A Rive path has more than %u vertices, and can't be drawn with 16 bit indices", MAX_TESS_VERTICES_16);
+                    continue;
+                }
+
+                // The indices are relative to the start of the buffer
+                uint32_t vertex_offset = world->m_TessVertices.Size() - buffer->m_VertexStart;
+                RiveVertex* vertices   = AllocTessData(world->m_TessVertices, desc.m_VerticesCount);
+
+                dmRender::RenderObject& ro = *NewTessRenderObject(world);
+                if (world->m_TessIndices32)
+                {
+                    ro.m_IndexType   = dmGraphics::TYPE_UNSIGNED_INT;
+                    ro.m_VertexStart = (world->m_TessIndices.Size() - buffer->m_IndexStart) * sizeof(uint32_t);
+                    CopyVertices(desc, vertex_offset, vertices, AllocTessData(world->m_TessIndices, desc.m_IndicesCount));
+                }
+                else
+                {
+                    ro.m_IndexType   = dmGraphics::TYPE_UNSIGNED_SHORT;
+                    ro.m_VertexStart = (world->m_TessIndices16.Size() - buffer->m_IndexStart) * sizeof(uint16_t);
+                    CopyVertices(desc, vertex_offset, vertices, AllocTessData(world->m_TessIndices16, desc.m_IndicesCount));
+                }
+
+                ro.m_Material           = material;
+                ro.m_VertexDeclaration  = vertex_declaration;
+                ro.m_VertexBuffer       = buffer->m_VertexBuffer;
+                ro.m_IndexBuffer        = buffer->m_IndexBuffer;
+                ro.m_PrimitiveType      = dmGraphics::PRIMITIVE_TRIANGLES;
+                ro.m_VertexCount        = desc.m_IndicesCount;
+                ro.m_Textures[0]        = texture;
+                ro.m_SetBlendFactors    = 1;
+                ro.m_SourceBlendFactor  = src_factor;
+                ro.m_DestinationBlendFactor = dst_factor;
+
+                const FsUniforms& fs_uniforms = desc.m_FsUniforms;
+                const VsUniforms& vs_uniforms = desc.m_VsUniforms;
+
+                dmVMath::Vector4 properties((float)fs_uniforms.fillType, (float) fs_uniforms.stopCount, 0.0f, 0.0f);
+                dmVMath::Vector4 gradient_limits(vs_uniforms.gradientStart.x, vs_uniforms.gradientStart.y, vs_uniforms.gradientEnd.x, vs_uniforms.gradientEnd.y);
+
+                dmVMath::Vector4* constant_values[4] = {
+                    &properties,
+                    &gradient_limits,
+                    (dmVMath::Vector4*) fs_uniforms.colors,
+                    (dmVMath::Vector4*) fs_uniforms.stops
+                };
+                uint32_t constant_value_counts[4] = {
+                    1,
+                    1,
+                    sizeof(fs_uniforms.colors) / sizeof(dmVMath::Vector4),
+                    sizeof(fs_uniforms.stops) / sizeof(dmVMath::Vector4)
+                };
+                for (uint32_t n = 0; n < DM_ARRAY_SIZE(constant_names); ++n)
+                {
+                    dmRender::SetNamedConstant(ro.m_ConstantBuffer, constant_names[n], constant_values[n], constant_value_counts[n], dmRenderDDF::MaterialDesc::CONSTANT_TYPE_USER);
+                }
+
+                ApplyDrawMode(ro, desc.m_DrawMode, desc.m_ClipIndex);
+
+                memcpy(&ro.m_WorldTransform, &vs_uniforms.world, sizeof(vs_uniforms.world));
+
+                dmRender::AddToRender(render_context, &ro);
             }
         }
     }
 
-    dmGameObject::CreateResult CompRiveAddToUpdate(const dmGameObject::ComponentAddToUpdateParams& params)
+    static void UploadTessBuffers(RiveWorld* world)
     {
-        RiveWorld* world = (RiveWorld*)params.m_World;
-        uint32_t index = (uint32_t)*params.m_UserData;
-        RiveComponent* component = world->m_Components.Get(index);
-        component->m_AddedToUpdate = true;
-        return dmGameObject::CREATE_RESULT_OK;
-    }
+        if (world->m_TessBufferCount == 0)
+            return;
 
-    static bool GetSender(RiveComponent* component, dmMessage::URL* out_sender)  
-    {
-        dmMessage::URL sender;
-        sender.m_Socket = dmGameObject::GetMessageSocket(dmGameObject::GetCollection(component->m_Instance));
-        if (dmMessage::IsSocketValid(sender.m_Socket))
+        DM_PROFILE("RiveUploadTessBuffers");
+        uint32_t index_count = world->m_TessIndices32 ? world->m_TessIndices.Size() : world->m_TessIndices16.Size();
+        for (uint32_t i = 0; i < world->m_TessBufferCount; ++i)
         {
-            dmGameObject::Result go_result = dmGameObject::GetComponentId(component->m_Instance, component->m_ComponentIndex, &sender.m_Fragment);
-            if (go_result == dmGameObject::RESULT_OK)
-            {
-                sender.m_Path = dmGameObject::GetIdentifier(component->m_Instance);
-                *out_sender = sender;
-                return true;
-            }
+            const RiveTessBuffer& buffer = world->m_TessBuffers[i];
+            bool last = i + 1 == world->m_TessBufferCount;
+            uint32_t vertex_end = last ? world->m_TessVertices.Size() : world->m_TessBuffers[i + 1].m_VertexStart;
+            uint32_t index_end  = last ? index_count : world->m_TessBuffers[i + 1].m_IndexStart;
+
+            dmGraphics::SetVertexBufferData(buffer.m_VertexBuffer, (vertex_end - buffer.m_VertexStart) * sizeof(RiveVertex), world->m_TessVertices.Begin() + buffer.m_VertexStart, dmGraphics::BUFFER_USAGE_DYNAMIC_DRAW);
+            if (world->m_TessIndices32)
+                dmGraphics::SetIndexBufferData(buffer.m_IndexBuffer, (index_end - buffer.m_IndexStart) * sizeof(uint32_t), world->m_TessIndices.Begin() + buffer.m_IndexStart, dmGraphics::BUFFER_USAGE_DYNAMIC_DRAW);
+            else
+                dmGraphics::SetIndexBufferData(buffer.m_IndexBuffer, (index_end - buffer.m_IndexStart) * sizeof(uint16_t), world->m_TessIndices16.Begin() + buffer.m_IndexStart, dmGraphics::BUFFER_USAGE_DYNAMIC_DRAW);
         }
-        return false;
     }
 
-    static void CompRiveAnimationReset(RiveComponent* component)
+    static void RenderBatch(RiveWorld* world, dmRender::HRenderContext render_context, dmRender::RenderListEntry *buf, uint32_t* begin, uint32_t* end)
     {
-        component->m_AnimationIndex        = 0xff;
+        if (world->m_Tessellation)
+        {
+            RenderBatchTess(world, render_context, buf, begin, end);
+            return;
+        }
+
+        bool has_content = false;
+        for (uint32_t *i=begin;i!=end;i++)
+        {
+            RiveComponentHot* hot = (RiveComponentHot*) buf[*i].m_UserData;
+            if (hot->m_Enabled && hot->m_AddedToUpdate)
+            {
+                has_content = true;
+                break;
+            }
+        }
+
+        // Nothing was drawn between this batch and the open group, so it is drawn into the same target
+        bool adjacent = world->m_RenderGroupEnd == begin;
+        if (!has_content)
+        {
+            if (adjacent)
+                world->m_RenderGroupEnd = end;
+            return;
+        }
+
+        // When out of targets, the rest of the batches are composited with the last group
+        if (!adjacent && world->m_RenderGroupCount < MAX_RENDER_GROUP_COUNT)
+        {
+            EndRenderGroup(world);
+        }
+
+        if (!world->m_RenderGroupEnd)
+        {
+            BeginRenderGroup(world, render_context);
+        }
+        world->m_RenderGroupEnd = end;
+
+        rive::Mat2D viewTransform = GetViewTransform(world->m_RiveRenderContext, render_context);
+        rive::Renderer* renderer = GetRiveRenderer(world->m_RiveRenderContext);
+
+        for (uint32_t *i=begin;i!=end;i++)
+        {
+            RiveComponentHot* hot = (RiveComponentHot*) buf[*i].m_UserData;
+
+            if (!hot->m_Enabled || !hot->m_AddedToUpdate)
+                continue;
+
+            DrawComponent(renderer, hot, viewTransform);
+        }
+    }
+
+    void UpdateTransforms(RiveWorld* world)
+    {
+        DM_PROFILE("UpdateTransforms");
+
+        // Rebuilt on the next pointer event
+        world->m_PointerIndexDirty = 1;
+
+        dmArray<RiveComponentHot>& components = world->m_Components.GetRawObjects();
+        uint32_t n = components.Size();
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            RiveComponentHot* c = &components[i];
+
+            if (!c->m_Enabled || !c->m_AddedToUpdate)
+                continue;
+
+            const Matrix4& go_world = dmGameObject::GetWorldMatrix(c->m_Instance);
+            const Matrix4 local = dmTransform::ToMatrix4(c->m_Transform);
+            // if (dmGameObject::ScaleAlongZ(c->m_Instance))
+            // {
+            //     c->m_World = go_world * local;
+            // }
+            // else
+            {
+                c->m_World = dmTransform::MulNoScaleZ(go_world, local);
+            }
+        }
+    }
+
+    dmGameObject::CreateResult CompRiveAddToUpdate(const dmGameObject::ComponentAddToUpdateParams& params)
+    {
+        RiveWorld* world = (RiveWorld*)params.m_World;
+        uint32_t index = (uint32_t)*params.m_UserData;
+        world->m_Components.Get(index).m_AddedToUpdate = 1;
+        world->m_PointerIndexDirty = 1;
+        world->m_ComponentsAdded = 1;
+        return dmGameObject::CREATE_RESULT_OK;
+    }
+
+    static bool GetSender(RiveComponent* component, dmMessage::URL* out_sender)  
+    {
+        dmMessage::URL sender;
+        sender.m_Socket = dmGameObject::GetMessageSocket(dmGameObject::GetCollection(component->m_Instance));
+        if (dmMessage::IsSocketValid(sender.m_Socket))
+        {
+            dmGameObject::Result go_result = dmGameObject::GetComponentId(component->m_Instance, component->m_ComponentIndex, &sender.m_Fragment);
+            if (go_result == dmGameObject::RESULT_OK)
+            {
+                sender.m_Path = dmGameObject::GetIdentifier(component->m_Instance);
+                *out_sender = sender;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void CompRiveAnimationReset(RiveComponent* component)
+    {
+        component->m_AnimationIndex        = 0xff;
         component->m_AnimationPlaybackRate = 1.0f;
         component->m_AnimationPlayback     = dmGameObject::PLAYBACK_NONE;
+        component->m_AnimationMix          = 1.0f;
 
+        ClearAnimationLayers(component);
         component->m_AnimationInstance.reset();
         component->m_StateMachineInstance.reset();
+        component->m_BakedAnimation = 0;
 
         component->m_StateMachineInputs.SetSize(0);
+        component->m_ReportedEvents.SetSize(0);
+        component->m_AnimationFinished = 0;
     }
 
     static void CompRiveAnimationDoneCallback(RiveComponent* component)
@@ -684,92 +1333,312 @@ namespace dmRive
         }
     }
 
+    // Advances the fading animations and the current animation, and applies them to the artboard in one pass
+    static void AdvanceAndApplyAnimationLayers(RiveComponent* component, float dt)
+    {
+        float animation_dt = dt * component->m_AnimationPlaybackRate;
+
+        uint32_t layer_count = component->m_AnimationLayers.Size();
+        for (uint32_t i = 0; i < layer_count; ++i)
+        {
+            component->m_AnimationLayers[i].m_Instance->advance(animation_dt);
+        }
+        component->m_AnimationInstance->advance(animation_dt);
+
+        // The crossfade is in game time, and isn't affected by the playback rate
+        component->m_AnimationMix = dmMath::Min(1.0f, component->m_AnimationMix + dt / component->m_AnimationCrossfadeTime);
+
+        // Each animation is mixed on top of the result of the previous ones
+        for (uint32_t i = 0; i < layer_count; ++i)
+        {
+            RiveAnimationLayer& layer = component->m_AnimationLayers[i];
+            layer.m_Instance->apply(i == 0 ? 1.0f : layer.m_Mix);
+        }
+        component->m_AnimationInstance->apply(component->m_AnimationMix);
+
+        component->m_ArtboardInstance->advance(animation_dt);
+        // The faded out layers are cleared by HandleAdvanceResults(), as they go back to the world pool
+    }
+
+    // Advances the animation or state machine, and the artboard.
+    // Only touches the component's own data, so it can run on a worker thread. See HandleAdvanceResults()
+    static void AdvanceComponent(RiveComponent* component, float dt)
+    {
+        if (component->m_AnimationFinished)
+        {
+            // Waiting for HandleAdvanceResults() to reset the animation
+            return;
+        }
+
+        if (component->m_StateMachineInstance)
+        {
+            component->m_StateMachineInstance->advanceAndApply(dt * component->m_AnimationPlaybackRate);
+
+            size_t event_count = component->m_StateMachineInstance->reportedEventCount();
+            for (size_t i = 0; i < event_count; i++)
+            {
+                rive::EventReport reported_event = component->m_StateMachineInstance->reportedEventAt(i);
+                if (component->m_ReportedEvents.Full())
+                    component->m_ReportedEvents.OffsetCapacity(4);
+                component->m_ReportedEvents.Push(reported_event.event());
+            }
+        }
+        else if (component->m_AnimationInstance)
+        {
+            if (component->m_AnimationLayers.Empty() && component->m_BakedAnimation)
+            {
+                float animation_dt = dt * component->m_AnimationPlaybackRate;
+                component->m_AnimationInstance->advance(animation_dt);
+                ApplyBakedAnimation(component->m_BakedAnimation, component->m_ArtboardInstance.get(), component->m_AnimationInstance->time());
+                component->m_ArtboardInstance->advance(animation_dt);
+            }
+            else if (component->m_AnimationLayers.Empty())
+            {
+                component->m_AnimationInstance->advanceAndApply(dt * component->m_AnimationPlaybackRate);
+            }
+            else
+            {
+                AdvanceAndApplyAnimationLayers(component, dt);
+            }
+
+            if (component->m_AnimationInstance->didLoop())
+            {
+                bool did_finish = false;
+                switch(component->m_AnimationPlayback)
+                {
+                    case dmGameObject::PLAYBACK_ONCE_FORWARD:
+                        did_finish = true;
+                        break;
+                    case dmGameObject::PLAYBACK_ONCE_BACKWARD:
+                        did_finish = true;
+                        break;
+                    case dmGameObject::PLAYBACK_ONCE_PINGPONG:
+                        did_finish = component->m_AnimationInstance->direction() > 0;
+                        break;
+                    default:break;
+                }
+
+                component->m_AnimationFinished = did_finish;
+            }
+        }
+        else {
+            component->m_ArtboardInstance->advance(dt * component->m_AnimationPlaybackRate);
+        }
+    }
+
+    // Sends the events and callbacks from the last advance. Runs on the main thread
+    static void HandleAdvanceResults(RiveComponent* component)
+    {
+        uint32_t event_count = component->m_ReportedEvents.Size();
+        for (uint32_t i = 0; i < event_count; ++i)
+        {
+            CompRiveEventTriggerCallback(component, component->m_ReportedEvents[i]);
+        }
+        component->m_ReportedEvents.SetSize(0);
+
+        if (!component->m_AnimationLayers.Empty() && component->m_AnimationMix >= 1.0f)
+        {
+            ClearAnimationLayers(component);
+        }
+
+        if (component->m_AnimationFinished)
+        {
+            component->m_AnimationFinished = 0;
+            CompRiveAnimationDoneCallback(component);
+            CompRiveAnimationReset(component);
+        }
+    }
+
+    static void AdvanceJob(void* _world, uint32_t index)
+    {
+        DM_PROFILE("RiveAdvance");
+        RiveWorld* world = (RiveWorld*)_world;
+        RiveComponent* component = world->m_AdvanceComponents[index];
+        for (uint32_t step = 0; step < world->m_AdvanceStepCount; ++step)
+        {
+            AdvanceComponent(component, world->m_AdvanceDt);
+        }
+    }
+
+    // In the pipelined mode, the components are advanced on the worker threads once they have been drawn,
+    // and the result is drawn in the next frame
+    static void StartAdvance(RiveWorld* world)
+    {
+        if (!world->m_AdvancePending)
+            return;
+        world->m_AdvancePending = 0;
+        world->m_AdvanceRunning = 1;
+        WorkerPoolStart(world->m_Ctx->m_WorkerPool, &world->m_AdvanceJob, AdvanceJob, world, world->m_AdvanceComponents.Size());
+    }
+
+    // Must be called before the components are accessed outside of the update
+    static void WaitForAdvance(RiveWorld* world)
+    {
+        if (!world->m_AdvanceRunning)
+            return;
+        DM_PROFILE("RiveWaitForAdvance");
+        WorkerPoolWait(world->m_Ctx->m_WorkerPool, &world->m_AdvanceJob);
+        world->m_AdvanceRunning = 0;
+    }
+
+    void CompRiveWaitForAdvances()
+    {
+        for (uint32_t i = 0; i < g_Worlds.Size(); ++i)
+        {
+            WaitForAdvance(g_Worlds[i]);
+        }
+    }
+
     dmGameObject::UpdateResult CompRiveUpdate(const dmGameObject::ComponentsUpdateParams& params, dmGameObject::ComponentsUpdateResult& update_result)
     {
         DM_PROFILE("RiveModel");
         RiveWorld* world    = (RiveWorld*)params.m_World;
 
-        float dt = params.m_UpdateContext->m_DT;
+        WaitForAdvance(world);
+        if (world->m_AdvancePending)
+        {
+            // The components weren't drawn in the last frame
+            StartAdvance(world);
+            WaitForAdvance(world);
+        }
+        if (world->m_DispatchCount > 0)
+            world->m_LastDispatchCount = world->m_DispatchCount;
+        world->m_DispatchCount = 0;
 
-        dmArray<RiveComponent*>& components = world->m_Components.GetRawObjects();
+        float dt = params.m_UpdateContext->m_DT * world->m_TimeScale;
+
+        dmArray<RiveComponentHot>& components = world->m_Components.GetRawObjects();
         const uint32_t count = components.Size();
         DM_PROPERTY_ADD_U32(rmtp_RiveComponents, count);
+        DM_PROPERTY_ADD_U32(rmtp_RiveInstances, world->m_InstanceCount);
+        DM_PROPERTY_ADD_U32(rmtp_RiveArtboardBytesEstimate, world->m_InstanceBytes);
+        DM_PROPERTY_SET_U32(rmtp_RiveTextureBytes, dmRive::GetTextureBytes());
+        DM_PROPERTY_ADD_U32(rmtp_RivePoolBytes, BlockPoolGetReservedBytes(&world->m_AnimationInstancePool) + BlockPoolGetReservedBytes(&world->m_StateMachineInstancePool));
+        DM_PROPERTY_ADD_U32(rmtp_RivePoolUsedBytes, BlockPoolGetUsedBytes(&world->m_AnimationInstancePool) + BlockPoolGetUsedBytes(&world->m_StateMachineInstancePool));
+
+        dmRive::TextCacheStats text_stats;
+        dmRive::GetTextCacheStats(&text_stats);
+        DM_PROPERTY_SET_U32(rmtp_RiveFonts, text_stats.m_FontCount);
+        DM_PROPERTY_SET_U32(rmtp_RiveShapedText, text_stats.m_ShapedTextCount);
+        DM_PROPERTY_SET_U32(rmtp_RiveGlyphs, text_stats.m_GlyphCount);
+
+        // When paused, nothing is advanced, unless new components need to be set up for rendering.
+        // The input and the attached game objects are still handled, as the components can be interacted with and moved,
+        // but the components are only visited when there is any of either
+        if (world->m_TimeScale == 0.0f && !world->m_ComponentsAdded)
+        {
+            uint32_t paused_count = (world->m_PointerEventCount > 0 || world->m_BoneAttachmentCount > 0) ? count : 0;
+            for (uint32_t i = 0; i < paused_count; ++i)
+            {
+                if (!components[i].m_Enabled || !components[i].m_AddedToUpdate)
+                    continue;
+
+                RiveComponent& component = *components[i].m_Component;
+                if (!component.m_PointerEvents.Empty())
+                {
+                    FlushPointerEvents(&components[i]);
+
+                    // Applies the listeners and reports their events, without moving the time
+                    if (component.m_StateMachineInstance)
+                    {
+                        AdvanceComponent(&component, 0.0f);
+                        HandleAdvanceResults(&component);
+                    }
+
+                    if (component.m_Resource->m_CreateGoBones)
+                        UpdateBones(&component);
+                }
+
+                // Looked up again, as the callbacks may have created components, which can move the hot data
+                if (!component.m_BoneAttachments.Empty())
+                    UpdateBoneAttachments(&components[i]);
+            }
+
+            update_result.m_TransformsUpdated = false;
+            return dmGameObject::UPDATE_RESULT_OK;
+        }
+        world->m_ComponentsAdded = 0;
+
+        // In fixed timestep mode, the components are advanced zero or more whole steps each frame
+        float step_dt = dt;
+        uint32_t step_count = 1;
+        if (world->m_FixedTimestep > 0.0f)
+        {
+            // Limit the catch up after a spike, so that a slow frame doesn't lead to even slower frames
+            world->m_TimeAccumulator = dmMath::Min(world->m_TimeAccumulator + dt, (double)world->m_FixedTimestep * world->m_MaxSubsteps);
+            step_count = (uint32_t)(world->m_TimeAccumulator / world->m_FixedTimestep);
+            world->m_TimeAccumulator -= (double)step_count * world->m_FixedTimestep;
+            step_dt = world->m_FixedTimestep;
+        }
+
+        bool pipelined = world->m_Ctx->m_PipelinedUpdate;
+        if (pipelined)
+        {
+            world->m_AdvanceComponents.SetSize(0);
+            world->m_AdvanceDt = step_dt;
+            world->m_AdvanceStepCount = step_count;
+        }
 
         for (uint32_t i = 0; i < count; ++i)
         {
-            RiveComponent& component = *components[i];
-            component.m_DoRender = 0;
+            // Not kept as a reference, since the callbacks run by HandleAdvanceResults() may create components,
+            // which can move the hot data
+            RiveComponentHot* hot = &components[i];
+            hot->m_DoRender = 0;
 
-            if (!component.m_Enabled || !component.m_AddedToUpdate)
+            // Check the flags first, so that the cold data of inactive components isn't touched
+            if (!hot->m_Enabled || !hot->m_AddedToUpdate)
             {
                 continue;
             }
 
             // RIVE UPDATE
+            RiveComponent& component = *hot->m_Component;
             dmRive::RiveSceneData* data = (dmRive::RiveSceneData*) component.m_Resource->m_Scene->m_Scene;
             rive::File* f               = data->m_File;
             rive::Artboard* artboard    = f->artboard();
 
             if (!artboard)
             {
-                component.m_Enabled = false;
+                hot->m_Enabled = false;
                 continue;
             }
-            rive::AABB artboard_bounds  = artboard->bounds();
 
-            if (component.m_StateMachineInstance)
+            // Sent before advancing, so that the listeners are evaluated once per frame rather than once per input event
+            if (!component.m_PointerEvents.Empty())
+                FlushPointerEvents(hot);
+
+            if (pipelined)
             {
-                component.m_StateMachineInstance->advanceAndApply(dt * component.m_AnimationPlaybackRate);
+                // The results of the advance that ran after the last frame was drawn
+                HandleAdvanceResults(&component);
 
-                size_t event_count = component.m_StateMachineInstance->reportedEventCount();
-                for (size_t i = 0; i < event_count; i++)
-                {
-                    rive::EventReport reported_event = component.m_StateMachineInstance->reportedEventAt(i);
-                    rive::Event* event = reported_event.event();
-                    CompRiveEventTriggerCallback(&component, event);
-                }
+                if (world->m_AdvanceComponents.Full())
+                    world->m_AdvanceComponents.OffsetCapacity(dmMath::Max(16u, count));
+                world->m_AdvanceComponents.Push(&component);
             }
-            else if (component.m_AnimationInstance)
+            else
             {
-                component.m_AnimationInstance->advanceAndApply(dt * component.m_AnimationPlaybackRate);
-
-                if (component.m_AnimationInstance->didLoop())
+                for (uint32_t step = 0; step < step_count; ++step)
                 {
-                    bool did_finish = false;
-                    switch(component.m_AnimationPlayback)
-                    {
-                        case dmGameObject::PLAYBACK_ONCE_FORWARD:
-                            did_finish = true;
-                            break;
-                        case dmGameObject::PLAYBACK_ONCE_BACKWARD:
-                            did_finish = true;
-                            break;
-                        case dmGameObject::PLAYBACK_ONCE_PINGPONG:
-                            did_finish = component.m_AnimationInstance->direction() > 0;
-                            break;
-                        default:break;
-                    }
-
-                    if (did_finish)
-                    {
-                        CompRiveAnimationDoneCallback(&component);
-                        CompRiveAnimationReset(&component);
-                    }
+                    AdvanceComponent(&component, step_dt);
+                    HandleAdvanceResults(&component);
                 }
             }
-            else {
-                component.m_ArtboardInstance->advance(dt * component.m_AnimationPlaybackRate);
-            }
 
             if (component.m_Resource->m_CreateGoBones)
                 UpdateBones(&component); // after the artboard->advance();
 
-            if (component.m_ReHash || (component.m_RenderConstants && dmGameSystem::AreRenderConstantsUpdated(component.m_RenderConstants)))
-            {
-                ReHash(&component);
-            }
+            hot = &components[i];
+            if (!component.m_BoneAttachments.Empty())
+                UpdateBoneAttachments(hot);
+
+            hot->m_DoRender = 1;
+        }
 
-            component.m_DoRender = 1;
+        if (pipelined && step_count > 0 && !world->m_AdvanceComponents.Empty())
+        {
+            world->m_AdvancePending = 1;
         }
 
         // If the child bones have been updated, we need to return true
@@ -786,7 +1655,15 @@ namespace dmRive
         {
             case dmRender::RENDER_LIST_OPERATION_BEGIN:
             {
-                world->m_RenderObjects.SetSize(0);
+                WaitForAdvance(world);
+                world->m_DispatchCount++;
+                world->m_RenderGroupEnd = 0;
+                world->m_RenderGroupCount = 0;
+                world->m_RenderObjectCount = 0;
+                world->m_TessVertices.SetSize(0);
+                world->m_TessIndices.SetSize(0);
+                world->m_TessIndices16.SetSize(0);
+                world->m_TessBufferCount = 0;
                 break;
             }
             case dmRender::RENDER_LIST_OPERATION_BATCH:
@@ -796,7 +1673,13 @@ namespace dmRive
             }
             case dmRender::RENDER_LIST_OPERATION_END:
             {
-                RenderBatchEnd(world, params.m_Context);
+                EndRenderGroup(world);
+                if (world->m_Tessellation)
+                    UploadTessBuffers(world);
+                // When the world is drawn by several predicates or cameras, all of them draw the same state.
+                // If there are fewer dispatches than in the last frame, the advance is started in the next update
+                if (world->m_DispatchCount >= world->m_LastDispatchCount)
+                    StartAdvance(world);
                 break;
             }
             default:
@@ -813,7 +1696,7 @@ namespace dmRive
         dmRender::HRenderContext render_context = context->m_RenderContext;
         RiveWorld* world = (RiveWorld*)params.m_World;
 
-        dmArray<RiveComponent*>& components = world->m_Components.GetRawObjects();
+        dmArray<RiveComponentHot>& components = world->m_Components.GetRawObjects();
         const uint32_t count = components.Size();
         if (!count)
         {
@@ -829,15 +1712,24 @@ namespace dmRive
 
         for (uint32_t i = 0; i < count; ++i)
         {
-            RiveComponent& component = *components[i];
-            if (!component.m_DoRender || !component.m_Enabled)
+            RiveComponentHot& hot = components[i];
+            if (!hot.m_DoRender || !hot.m_Enabled)
             {
                 continue;
             }
-            const Vector4 trans        = component.m_World.getCol(3);
+
+            RiveComponent& component = *hot.m_Component;
+
+            // Done here rather than in the update, since the update is skipped when the world is paused
+            if (hot.m_ReHash || (component.m_RenderConstants && dmGameSystem::AreRenderConstantsUpdated(component.m_RenderConstants)))
+            {
+                ReHash(&hot);
+            }
+
+            const Vector4 trans        = hot.m_World.getCol(3);
             write_ptr->m_WorldPosition = Point3(trans.getX(), trans.getY(), trans.getZ());
-            write_ptr->m_UserData      = (uintptr_t) &component;
-            write_ptr->m_BatchKey      = component.m_MixedHash;
+            write_ptr->m_UserData      = (uintptr_t) &hot;
+            write_ptr->m_BatchKey      = hot.m_MixedHash;
             write_ptr->m_TagListKey    = dmRender::GetMaterialTagListKey(GetMaterial(&component, component.m_Resource));
             write_ptr->m_Dispatch      = dispatch;
             write_ptr->m_MinorOrder    = 0;
@@ -861,7 +1753,7 @@ namespace dmRive
         if (!component->m_RenderConstants)
             component->m_RenderConstants = dmGameSystem::CreateRenderConstants();
         dmGameSystem::SetRenderConstant(component->m_RenderConstants, GetMaterial(component, component->m_Resource), name_hash, value_index, element_index, var);
-        component->m_ReHash = 1;
+        GetHot(component)->m_ReHash = 1;
     }
 
     static int FindAnimationIndex(dmhash_t* entries, uint32_t num_entries, dmhash_t anim_id)
@@ -916,9 +1808,50 @@ namespace dmRive
             return false;
         }
 
+        // Allocated first, so that the current animation is kept if it fails
+        RiveAnimationInstancePtr instance = NewAnimationInstance(component, animation_index);
+        if (!instance) {
+            return false;
+        }
+
+        // Keep the current animations, so that the new animation can be faded in on top of them
+        dmArray<RiveAnimationLayer> layers;
+        float crossfade_time = ddf->m_CrossfadeTime;
+        if (crossfade_time > 0.0f && component->m_AnimationInstance)
+        {
+            layers.Swap(component->m_AnimationLayers);
+            if (layers.Full())
+            {
+                layers.OffsetCapacity(4);
+            }
+            RiveAnimationLayer layer;
+            layer.m_Instance = component->m_AnimationInstance.release();
+            layer.m_Mix      = component->m_AnimationMix;
+            layers.Push(layer);
+        }
+
         CompRiveAnimationReset(component);
         CompRiveClearCallback(component);
 
+        if (!layers.Empty())
+        {
+            // The layers are dropped once the new animation is fully faded in, but the number of
+            // layers may still grow if the animations are changed faster than that
+            if (layers.Size() > MAX_ANIMATION_LAYER_COUNT)
+            {
+                uint32_t remove_count = layers.Size() - MAX_ANIMATION_LAYER_COUNT;
+                for (uint32_t i = 0; i < remove_count; ++i)
+                {
+                    DeleteAnimationInstance(component, layers[i].m_Instance);
+                }
+                memmove(&layers[0], &layers[remove_count], MAX_ANIMATION_LAYER_COUNT * sizeof(RiveAnimationLayer));
+                layers.SetSize(MAX_ANIMATION_LAYER_COUNT);
+            }
+            component->m_AnimationLayers.Swap(layers);
+            component->m_AnimationMix           = 0.0f;
+            component->m_AnimationCrossfadeTime = crossfade_time;
+        }
+
         rive::Loop loop_value = rive::Loop::oneShot;
         int play_direction    = 1;
         float play_time       = animation->startSeconds();
@@ -959,11 +1892,16 @@ namespace dmRive
         component->m_AnimationPlaybackRate = playback_rate;
         component->m_AnimationPlayback     = playback_mode;
         component->m_StateMachineInstance  = nullptr;
-        component->m_AnimationInstance     = component->m_ArtboardInstance->animationAt(animation_index);
-        component->m_AnimationInstance->inputCount();
+        component->m_AnimationInstance     = std::move(instance);
         component->m_AnimationInstance->time(play_time + offset_value);
         component->m_AnimationInstance->loopValue((int)loop_value);
         component->m_AnimationInstance->direction(play_direction);
+
+        // Until a reloaded file has been reinstanced, the component uses the animations from the previous file
+        if (component->m_Resource->m_BakeAnimations && component->m_File == data->m_File)
+        {
+            component->m_BakedAnimation = GetBakedAnimation(data, component->m_Resource->m_DDF->m_Artboard, component->m_AnimationInstance->animation());
+        }
         return true;
     }
 
@@ -980,15 +1918,26 @@ namespace dmRive
             return false;
         }
 
+        // Allocated first, so that the current state machine is kept if it fails
+        RiveStateMachineInstancePtr instance = NewStateMachineInstance(component, state_machine_index);
+        if (!instance) {
+            return false;
+        }
+
         CompRiveAnimationReset(component);
         CompRiveClearCallback(component);
 
         component->m_Callback              = callback_info;
         component->m_CallbackId++;
         component->m_AnimationInstance     = nullptr;
-        component->m_StateMachineInstance  = component->m_ArtboardInstance->stateMachineAt(state_machine_index);
+        component->m_StateMachineInstance  = std::move(instance);
         component->m_AnimationPlaybackRate = playback_rate;
 
+        if (component->m_ViewModelInstance)
+        {
+            component->m_StateMachineInstance->dataContextFromInstance(component->m_ViewModelInstance.get());
+        }
+
         // update the list of current state machine inputs
         uint32_t count = component->m_StateMachineInstance->inputCount();
         if (count > component->m_StateMachineInputs.Capacity())
@@ -1008,14 +1957,16 @@ namespace dmRive
     dmGameObject::UpdateResult CompRiveOnMessage(const dmGameObject::ComponentOnMessageParams& params)
     {
         RiveWorld* world = (RiveWorld*)params.m_World;
-        RiveComponent* component = world->m_Components.Get(*params.m_UserData);
+        WaitForAdvance(world);
+        RiveComponentHot* hot = &world->m_Components.Get(*params.m_UserData);
+        RiveComponent* component = hot->m_Component;
         if (params.m_Message->m_Id == dmGameObjectDDF::Enable::m_DDFDescriptor->m_NameHash)
         {
-            component->m_Enabled = 1;
+            hot->m_Enabled = 1;
         }
         else if (params.m_Message->m_Id == dmGameObjectDDF::Disable::m_DDFDescriptor->m_NameHash)
         {
-            component->m_Enabled = 0;
+            hot->m_Enabled = 0;
         }
         else if (params.m_Message->m_Descriptor != 0x0)
         {
@@ -1048,45 +1999,168 @@ namespace dmRive
         return dmGameObject::UPDATE_RESULT_OK;
     }
 
-    static bool OnResourceReloaded(RiveWorld* world, RiveComponent* component, int index)
+    // Recreates the artboard instance from the reloaded file, and carries over
+    // the current animation or state machine, its time and input values
+    static void ReloadArtboardInstance(RiveWorld* world, RiveComponent* component)
     {
-        // Make it regenerate the batch key
-        component->m_ReHash = 1;
-        return true;
-    }
+        dmRiveDDF::RivePlayAnimation ddf;
+        ddf.m_AnimationId    = 0;
+        ddf.m_Playback       = component->m_AnimationPlayback;
+        ddf.m_Offset         = 0.0;
+        ddf.m_PlaybackRate   = component->m_AnimationPlaybackRate;
+        ddf.m_IsStateMachine = component->m_StateMachineInstance != 0;
+        ddf.m_CrossfadeTime  = 0.0f;
 
-    void CompRiveOnReload(const dmGameObject::ComponentOnReloadParams& params)
-    {
-        RiveWorld* world = (RiveWorld*)params.m_World;
-        int index = *params.m_UserData;
-        RiveComponent* component = GetComponentFromIndex(world, index);
-        component->m_Resource = (RiveModelResource*)params.m_Resource;
-        (void)OnResourceReloaded(world, component, index);
-    }
+        float time      = 0.0f;
+        int direction   = 1;
 
-    static int FindStateMachineInputIndex(RiveComponent* component, dmhash_t property_name)
-    {
-        uint32_t count = component->m_StateMachineInputs.Size();
-        for (uint32_t i = 0; i < count; ++i)
+        // The values of the bool and number inputs (1:1 with m_StateMachineInputs)
+        dmArray<float> input_values;
+
+        if (component->m_StateMachineInstance)
         {
-            if (component->m_StateMachineInputs[i] == property_name)
+            ddf.m_AnimationId = dmHashString64(component->m_StateMachineInstance->stateMachine()->name().c_str());
+
+            uint32_t count = component->m_StateMachineInputs.Size();
+            input_values.SetCapacity(count);
+            input_values.SetSize(count);
+            for (uint32_t i = 0; i < count; ++i)
             {
-                return (int)i;
+                const rive::StateMachineInput* input = component->m_StateMachineInstance->stateMachine()->input(i);
+                rive::SMIInput* input_instance = component->m_StateMachineInstance->input(i);
+                if (input->is<rive::StateMachineBool>())
+                    input_values[i] = ((rive::SMIBool*)input_instance)->value() ? 1.0f : 0.0f;
+                else if (input->is<rive::StateMachineNumber>())
+                    input_values[i] = ((rive::SMINumber*)input_instance)->value();
             }
         }
-        return -1;
-    }
+        else if (component->m_AnimationInstance)
+        {
+            ddf.m_AnimationId = dmHashString64(component->m_AnimationInstance->animation()->name().c_str());
+            time              = component->m_AnimationInstance->time();
+            direction         = component->m_AnimationInstance->direction();
+        }
 
-    static dmGameObject::PropertyResult SetStateMachineInput(RiveComponent* component, int index, const dmGameObject::ComponentSetPropertyParams& params)
-    {
-        const rive::StateMachine* state_machine = component->m_StateMachineInstance->stateMachine();
-        const rive::StateMachineInput* input = state_machine->input(index);
-        rive::SMIInput* input_instance = component->m_StateMachineInstance->input(index);
+        dmArray<dmhash_t> input_names;
+        input_names.Swap(component->m_StateMachineInputs);
 
-        if (input->is<rive::StateMachineTrigger>())
-        {
-            if (params.m_Value.m_Type != dmGameObject::PROPERTY_TYPE_BOOLEAN)
-            {
+        // Keep the callback, since it belongs to the same playback
+        dmScript::LuaCallbackInfo* callback = component->m_Callback;
+        component->m_Callback = 0;
+
+        // The old instances reference the previous file, so they must go before the artboard
+        ClearAnimationLayers(component);
+        component->m_AnimationInstance.reset();
+        component->m_StateMachineInstance.reset();
+        CreateArtboardInstance(component);
+        component->m_TextRuns.Clear();
+        component->m_NamedBones.Clear();
+        ResolveBoneAttachments(component);
+
+        if (component->m_Resource->m_CreateGoBones)
+        {
+            component->m_Bones.SetSize(0);
+            dmRive::GetAllBones(component->m_ArtboardInstance.get(), &component->m_Bones);
+            if (component->m_Bones.Size() != component->m_BoneGOs.Size())
+            {
+                DeleteBones(component);
+                CreateBones(world, component);
+            }
+            UpdateBones(component);
+        }
+
+        if (ddf.m_AnimationId == 0)
+        {
+            component->m_Callback = callback;
+            return;
+        }
+
+        bool result = ddf.m_IsStateMachine ? CompRivePlayStateMachine(component, &ddf, callback) : CompRivePlayAnimation(component, &ddf, callback);
+        if (!result)
+        {
+            dmLogWarning("Couldn't find '%s' in the reloaded file", dmHashReverseSafe64(ddf.m_AnimationId));
+            if (callback)
+                dmScript::DestroyCallback(callback);
+            return;
+        }
+
+        if (component->m_StateMachineInstance)
+        {
+            uint32_t count = component->m_StateMachineInputs.Size();
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                // The inputs may have been added, removed or reordered
+                uint32_t old_index = 0;
+                for (; old_index < input_names.Size(); ++old_index)
+                {
+                    if (input_names[old_index] == component->m_StateMachineInputs[i])
+                        break;
+                }
+                if (old_index == input_names.Size())
+                    continue;
+
+                const rive::StateMachineInput* input = component->m_StateMachineInstance->stateMachine()->input(i);
+                rive::SMIInput* input_instance = component->m_StateMachineInstance->input(i);
+                if (input->is<rive::StateMachineBool>())
+                    ((rive::SMIBool*)input_instance)->value(input_values[old_index] != 0.0f);
+                else if (input->is<rive::StateMachineNumber>())
+                    ((rive::SMINumber*)input_instance)->value(input_values[old_index]);
+            }
+        }
+        else if (component->m_AnimationInstance)
+        {
+            component->m_AnimationInstance->time(time);
+            component->m_AnimationInstance->direction(direction);
+        }
+    }
+
+    static bool OnResourceReloaded(RiveWorld* world, RiveComponent* component, int index)
+    {
+        // Make it regenerate the batch key
+        GetHot(component)->m_ReHash = 1;
+
+        // Only reinstance the components where the rive file itself changed
+        dmRive::RiveSceneData* data = (dmRive::RiveSceneData*) component->m_Resource->m_Scene->m_Scene;
+        if (component->m_File != data->m_File)
+        {
+            ReloadArtboardInstance(world, component);
+        }
+        return true;
+    }
+
+    void CompRiveOnReload(const dmGameObject::ComponentOnReloadParams& params)
+    {
+        RiveWorld* world = (RiveWorld*)params.m_World;
+        WaitForAdvance(world);
+        int index = *params.m_UserData;
+        RiveComponent* component = GetComponentFromIndex(world, index);
+        component->m_Resource = (RiveModelResource*)params.m_Resource;
+        (void)OnResourceReloaded(world, component, index);
+    }
+
+    static int FindStateMachineInputIndex(RiveComponent* component, dmhash_t property_name)
+    {
+        uint32_t count = component->m_StateMachineInputs.Size();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (component->m_StateMachineInputs[i] == property_name)
+            {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+
+    static dmGameObject::PropertyResult SetStateMachineInput(RiveComponent* component, int index, const dmGameObject::ComponentSetPropertyParams& params)
+    {
+        const rive::StateMachine* state_machine = component->m_StateMachineInstance->stateMachine();
+        const rive::StateMachineInput* input = state_machine->input(index);
+        rive::SMIInput* input_instance = component->m_StateMachineInstance->input(index);
+
+        if (input->is<rive::StateMachineTrigger>())
+        {
+            if (params.m_Value.m_Type != dmGameObject::PROPERTY_TYPE_BOOLEAN)
+            {
                 dmLogError("Found property %s of type trigger, but didn't receive a boolean", input->name().c_str());
                 return dmGameObject::PROPERTY_RESULT_TYPE_MISMATCH;
             }
@@ -1157,6 +2231,7 @@ namespace dmRive
     {
         CompRiveContext* context = (CompRiveContext*)params.m_Context;
         RiveWorld* world = (RiveWorld*)params.m_World;
+        WaitForAdvance(world);
         RiveComponent* component = GetComponentFromIndex(world, *params.m_UserData);
         dmRive::RiveSceneData* data = (dmRive::RiveSceneData*) component->m_Resource->m_Scene->m_Scene;
 
@@ -1203,7 +2278,8 @@ namespace dmRive
     dmGameObject::PropertyResult CompRiveSetProperty(const dmGameObject::ComponentSetPropertyParams& params)
     {
         RiveWorld* world = (RiveWorld*)params.m_World;
-        RiveComponent* component = world->m_Components.Get(*params.m_UserData);
+        WaitForAdvance(world);
+        RiveComponent* component = GetComponentFromIndex(world, *params.m_UserData);
         if (params.m_PropertyId == PROP_CURSOR)
         {
             if (params.m_Value.m_Type != dmGameObject::PROPERTY_TYPE_NUMBER)
@@ -1230,7 +2306,7 @@ namespace dmRive
         {
             CompRiveContext* context = (CompRiveContext*)params.m_Context;
             dmGameObject::PropertyResult res = dmGameSystem::SetResourceProperty(context->m_Factory, params.m_Value, MATERIAL_EXT_HASH, (void**)&component->m_Material);
-            component->m_ReHash |= res == dmGameObject::PROPERTY_RESULT_OK;
+            GetHot(component)->m_ReHash |= res == dmGameObject::PROPERTY_RESULT_OK;
             return res;
         } else {
             if (component->m_StateMachineInstance)
@@ -1248,13 +2324,15 @@ namespace dmRive
     static void ResourceReloadedCallback(const dmResource::ResourceReloadedParams* params)
     {
         RiveWorld* world = (RiveWorld*) params->m_UserData;
-        dmArray<RiveComponent*>& components = world->m_Components.GetRawObjects();
+        WaitForAdvance(world);
+        dmArray<RiveComponentHot>& components = world->m_Components.GetRawObjects();
         uint32_t n = components.Size();
         for (uint32_t i = 0; i < n; ++i)
         {
-            RiveComponent* component = components[i];
+            RiveComponent* component = components[i].m_Component;
             RiveModelResource* resource = component->m_Resource;
-            if (!component->m_Enabled || !resource)
+            // Note: Disabled components are also reloaded, as the previous file will be deleted on the next reload
+            if (!resource)
                 continue;
 
             void* current_resource = dmResource::GetResource(params->m_Resource);
@@ -1274,6 +2352,14 @@ namespace dmRive
         rivectx->m_GraphicsContext  = *(dmGraphics::HContext*)ctx->m_Contexts.Get(dmHashString64("graphics"));
         rivectx->m_RenderContext    = *(dmRender::HRenderContext*)ctx->m_Contexts.Get(dmHashString64("render"));
         rivectx->m_MaxInstanceCount = dmConfigFile::GetInt(ctx->m_Config, "rive.max_instance_count", 128);
+        rivectx->m_FixedTimestep = dmMath::Max(0.0f, dmConfigFile::GetFloat(ctx->m_Config, "rive.fixed_timestep", 0.0f));
+        rivectx->m_MaxSubsteps = dmMath::Max(1, dmConfigFile::GetInt(ctx->m_Config, "rive.max_substeps", 4));
+        rivectx->m_PipelinedUpdate = dmConfigFile::GetInt(ctx->m_Config, "rive.pipelined_update", 0) != 0;
+        SetRestorePipelineState(dmConfigFile::GetInt(ctx->m_Config, "rive.restore_state", 1) != 0);
+        if (rivectx->m_PipelinedUpdate)
+        {
+            rivectx->m_WorkerPool = NewWorkerPool(dmMath::Max(0, dmConfigFile::GetInt(ctx->m_Config, "rive.worker_threads", 2)));
+        }
 
         float scale_factor_width = (float) dmGraphics::GetWindowWidth(rivectx->m_GraphicsContext) / (float) dmGraphics::GetWidth(rivectx->m_GraphicsContext);
         float scale_factor_height = (float) dmGraphics::GetWindowHeight(rivectx->m_GraphicsContext) / (float) dmGraphics::GetHeight(rivectx->m_GraphicsContext);
@@ -1311,6 +2397,7 @@ namespace dmRive
     static dmGameObject::Result ComponentTypeDestroy(const dmGameObject::ComponentTypeCreateCtx* ctx, dmGameObject::ComponentType* type)
     {
         CompRiveContext* rivectx = (CompRiveContext*)ComponentTypeGetContext(type);
+        DeleteWorkerPool(rivectx->m_WorkerPool);
         delete rivectx;
         return dmGameObject::RESULT_OK;
     }
@@ -1330,6 +2417,7 @@ namespace dmRive
             }
         }
         component->m_BoneGOs.SetSize(0);
+        component->m_BoneTransforms.SetSize(0);
     }
 
     static void UpdateBones(RiveComponent* component)
@@ -1343,35 +2431,167 @@ namespace dmRive
         uint32_t num_bones = component->m_BoneGOs.Size();
         DM_PROPERTY_ADD_U32(rmtp_RiveBones, num_bones);
 
-        dmVMath::Point3 go_pos = dmGameObject::GetPosition(component->m_Instance);
+        // See m_BoneTransforms
+        float* prev_x  = component->m_BoneTransforms.Begin();
+        float* prev_y  = prev_x + num_bones;
+        float* prev_qz = prev_y + num_bones;
+        float* prev_qw = prev_qz + num_bones;
+        float* x       = prev_qw + num_bones;
+        float* y       = x + num_bones;
+        float* qz      = y + num_bones;
+        float* qw      = qz + num_bones;
+
+        // Gather the bone transforms. The x axis is temporarily stored in the rotation arrays
+        for (uint32_t i = 0; i < num_bones; ++i)
+        {
+            const rive::Mat2D& rt = component->m_Bones[i]->worldTransform();
+            x[i]  = rt.tx();
+            y[i]  = rt.ty();
+            qz[i] = rt.xx();
+            qw[i] = rt.xy();
+        }
 
+        // Convert to the game object space, in a loop without calls or branches so that it can be vectorized.
+        // The rotation is -atan2(x axis) around z, which is calculated from the x axis using the half angle formulas
         for (uint32_t i = 0; i < num_bones; ++i)
         {
+            float ax  = qz[i];
+            float ay  = qw[i];
+            float len = sqrtf(ax * ax + ay * ay);
+            float c   = len > 0.0f ? ax / len : 1.0f;
+            float s   = len > 0.0f ? ay / len : 0.0f;
+            float half_sin = sqrtf(dmMath::Max(0.0f, (1.0f - c) * 0.5f));
+            float half_cos = sqrtf(dmMath::Max(0.0f, (1.0f + c) * 0.5f));
+            qz[i] = s < 0.0f ? half_sin : -half_sin;
+            qw[i] = half_cos;
+
+            // Since the Rive space is different, we need to flip the y axis
+            x[i] = x[i] - cx;
+            y[i] = cy - y[i];
+        }
+
+        // Only update the game objects that moved, since each update dirties the game object transform
+        for (uint32_t i = 0; i < num_bones; ++i)
+        {
+            if (x[i] == prev_x[i] && y[i] == prev_y[i] && qz[i] == prev_qz[i] && qw[i] == prev_qw[i])
+            {
+                continue;
+            }
+
             dmGameObject::HInstance bone_instance = component->m_BoneGOs[i];
-            rive::Bone* bone = component->m_Bones[i];
+            dmGameObject::SetPosition(bone_instance, Point3(x[i], y[i], 0.0f));
+            dmGameObject::SetRotation(bone_instance, Quat(0.0f, 0.0f, qz[i], qw[i]));
 
-            const rive::Mat2D& rt = bone->worldTransform();
+            prev_x[i]  = x[i];
+            prev_y[i]  = y[i];
+            prev_qz[i] = qz[i];
+            prev_qw[i] = qw[i];
+        }
+    }
 
-            dmVMath::Vector4 x_axis(rt.xx(), rt.xy(), 0, 0);
-            dmVMath::Vector4 y_axis(rt.yx(), rt.yy(), 0, 0);
+    static rive::Bone* FindBone(RiveComponent* component, dmhash_t name_hash)
+    {
+        rive::Bone** cached = component->m_NamedBones.Get(name_hash);
+        if (cached)
+        {
+            return *cached;
+        }
+
+        rive::Bone* bone = 0;
+        for (rive::Core* object : component->m_ArtboardInstance->objects())
+        {
+            if (object != 0 && object->is<rive::Bone>())
+            {
+                rive::Bone* b = object->as<rive::Bone>();
+                if (dmHashString64(b->name().c_str()) == name_hash)
+                {
+                    bone = b;
+                    break;
+                }
+            }
+        }
 
-            float scale_x = length(x_axis);
-            float scale_y = length(y_axis);
-            dmVMath::Vector3 scale(scale_x, scale_y, 1);
+        if (!bone)
+        {
+            return 0;
+        }
 
-            float angle = atan2f(x_axis.getY(), x_axis.getX());
-            Quat rotation = Quat::rotationZ(-angle);
+        if (component->m_NamedBones.Full())
+        {
+            component->m_NamedBones.OffsetCapacity(8);
+        }
+        component->m_NamedBones.Put(name_hash, bone);
+        return bone;
+    }
 
-            // Since the Rive space is different, we need to flip the y axis
-            dmVMath::Vector3 pos(rt.tx() - cx, -rt.ty() + cy, 0);
+    // The world transform of the component, as calculated in UpdateTransforms()
+    static Matrix4 GetComponentWorldMatrix(RiveComponentHot* hot)
+    {
+        return dmTransform::MulNoScaleZ(dmGameObject::GetWorldMatrix(hot->m_Instance), dmTransform::ToMatrix4(hot->m_Transform));
+    }
+
+    // The bone transform in the space of the component. Same as the transforms of the bone game objects (see UpdateBones())
+    static Matrix4 GetBoneMatrix(RiveComponent* component, rive::Bone* bone)
+    {
+        rive::AABB bounds = component->m_ArtboardInstance->bounds();
+        float cx = (bounds.maxX - bounds.minX) * 0.5f;
+        float cy = (bounds.maxY - bounds.minY) * 0.5f;
+
+        const rive::Mat2D& rt = bone->worldTransform();
+        float angle = atan2f(rt.xy(), rt.xx());
+        return Matrix4(Quat::rotationZ(-angle), dmVMath::Vector3(rt.tx() - cx, cy - rt.ty(), 0.0f));
+    }
+
+    // After a reload, the attachments are moved to the bones with the same names in the new artboard
+    static void RemoveBoneAttachment(RiveComponent* component, uint32_t index)
+    {
+        component->m_BoneAttachments.EraseSwap(index);
+        component->m_RiveWorld->m_BoneAttachmentCount--;
+    }
+
+    static void ResolveBoneAttachments(RiveComponent* component)
+    {
+        for (uint32_t i = component->m_BoneAttachments.Size(); i > 0; --i)
+        {
+            RiveBoneAttachment& attachment = component->m_BoneAttachments[i - 1];
+            attachment.m_Bone = FindBone(component, attachment.m_BoneName);
+            if (!attachment.m_Bone)
+            {
+                dmLogWarning("The bone '%s' no longer exists, detaching '%s'", dmHashReverseSafe64(attachment.m_BoneName), dmHashReverseSafe64(attachment.m_InstanceId));
+                RemoveBoneAttachment(component, i - 1);
+            }
+        }
+    }
+
+    static void UpdateBoneAttachments(RiveComponentHot* hot)
+    {
+        RiveComponent* component = hot->m_Component;
+        dmGameObject::HCollection collection = dmGameObject::GetCollection(component->m_Instance);
+        Matrix4 component_world = GetComponentWorldMatrix(hot);
+
+        for (uint32_t i = component->m_BoneAttachments.Size(); i > 0; --i)
+        {
+            RiveBoneAttachment& attachment = component->m_BoneAttachments[i - 1];
 
-            dmVMath::Matrix4 world_transform(rotation, pos);
+            // Looked up by id each frame, since the game object may have been deleted
+            dmGameObject::HInstance instance = dmGameObject::GetInstanceFromIdentifier(collection, attachment.m_InstanceId);
+            if (!instance)
+            {
+                RemoveBoneAttachment(component, i - 1);
+                continue;
+            }
 
-            dmTransform::Transform transform = dmTransform::ToTransform(world_transform);
+            Matrix4 world = component_world * GetBoneMatrix(component, attachment.m_Bone);
 
-            dmGameObject::SetPosition(bone_instance, Point3(transform.GetTranslation()));
-            dmGameObject::SetRotation(bone_instance, transform.GetRotation());
-            dmGameObject::SetScale(bone_instance, transform.GetScale());
+            dmGameObject::HInstance parent = dmGameObject::GetParent(instance);
+            if (parent)
+            {
+                world = dmVMath::Inverse(dmGameObject::GetWorldMatrix(parent)) * world;
+            }
+
+            dmTransform::Transform transform = dmTransform::ToTransform(world);
+            dmGameObject::SetPosition(instance, Point3(transform.GetTranslation()));
+            dmGameObject::SetRotation(instance, transform.GetRotation());
         }
     }
 
@@ -1385,6 +2605,14 @@ namespace dmRive
         component->m_BoneGOs.SetCapacity(num_bones);
         component->m_BoneGOs.SetSize(num_bones);
 
+        // The previous transforms are invalid, so that all bones are written on the first update
+        component->m_BoneTransforms.SetCapacity(num_bones * 8);
+        component->m_BoneTransforms.SetSize(num_bones * 8);
+        for (uint32_t i = 0; i < num_bones * 4; ++i)
+        {
+            component->m_BoneTransforms[i] = NAN;
+        }
+
         for (uint32_t i = 0; i < num_bones; ++i)
         {
             dmGameObject::HInstance bone_instance = dmGameObject::New(collection, 0x0);
@@ -1426,6 +2654,220 @@ namespace dmRive
     // SCRIPTING HELPER FUNCTIONS
     // ******************************************************************************
 
+    bool CompRiveGetBoneTransform(RiveComponent* component, dmhash_t bone_name, dmVMath::Point3* position, dmVMath::Quat* rotation)
+    {
+        rive::Bone* bone = FindBone(component, bone_name);
+        if (!bone)
+        {
+            return false;
+        }
+
+        Matrix4 world = GetComponentWorldMatrix(GetHot(component)) * GetBoneMatrix(component, bone);
+        dmTransform::Transform transform = dmTransform::ToTransform(world);
+        *position = Point3(transform.GetTranslation());
+        *rotation = transform.GetRotation();
+        return true;
+    }
+
+    bool CompRiveAttachToBone(RiveComponent* component, dmhash_t bone_name, dmhash_t instance_id)
+    {
+        rive::Bone* bone = FindBone(component, bone_name);
+        if (!bone)
+        {
+            return false;
+        }
+
+        // A game object can only follow one bone
+        CompRiveDetachFromBone(component, instance_id);
+
+        if (component->m_BoneAttachments.Full())
+        {
+            component->m_BoneAttachments.OffsetCapacity(4);
+        }
+        RiveBoneAttachment attachment;
+        attachment.m_Bone       = bone;
+        attachment.m_BoneName   = bone_name;
+        attachment.m_InstanceId = instance_id;
+        component->m_BoneAttachments.Push(attachment);
+        component->m_RiveWorld->m_BoneAttachmentCount++;
+        return true;
+    }
+
+    void CompRiveDetachFromBone(RiveComponent* component, dmhash_t instance_id)
+    {
+        for (uint32_t i = 0; i < component->m_BoneAttachments.Size(); ++i)
+        {
+            if (component->m_BoneAttachments[i].m_InstanceId == instance_id)
+            {
+                RemoveBoneAttachment(component, i);
+                return;
+            }
+        }
+    }
+
+    static rive::TextValueRun* FindTextRun(RiveComponent* component, dmhash_t name_hash)
+    {
+        rive::TextValueRun** cached = component->m_TextRuns.Get(name_hash);
+        if (cached)
+        {
+            return *cached;
+        }
+
+        rive::TextValueRun* text_run = 0;
+        for (rive::Core* object : component->m_ArtboardInstance->objects())
+        {
+            if (object != 0 && object->is<rive::TextValueRun>())
+            {
+                rive::TextValueRun* run = object->as<rive::TextValueRun>();
+                if (dmHashString64(run->name().c_str()) == name_hash)
+                {
+                    text_run = run;
+                    break;
+                }
+            }
+        }
+
+        if (!text_run)
+        {
+            return 0;
+        }
+
+        if (component->m_TextRuns.Full())
+        {
+            component->m_TextRuns.OffsetCapacity(8);
+        }
+        component->m_TextRuns.Put(name_hash, text_run);
+        return text_run;
+    }
+
+    bool CompRiveSetTextRun(RiveComponent* component, dmhash_t name_hash, const char* text)
+    {
+        rive::TextValueRun* text_run = FindTextRun(component, name_hash);
+        if (!text_run)
+        {
+            return false;
+        }
+
+        // Avoid creating a new string (and the relayout of the text) if the text is the same
+        if (strcmp(text_run->text().c_str(), text) != 0)
+        {
+            text_run->text(text);
+        }
+        return true;
+    }
+
+    rive::ViewModelInstanceValue* CompRiveGetViewModelProperty(RiveComponent* component, rive::ViewModelInstance* instance, const char* name)
+    {
+        // Only the properties of the component's own instance are cached, as it is the only one that is known to live
+        // as long as the cache. Nested instances and list items may be replaced, and a new instance may reuse the address
+        if (instance != component->m_ViewModelInstance.get())
+        {
+            return instance->propertyValue(std::string(name));
+        }
+
+        dmhash_t key = dmHashString64(name);
+        rive::ViewModelInstanceValue** cached = component->m_ViewModelProperties.Get(key);
+        if (cached)
+        {
+            return *cached;
+        }
+
+        rive::ViewModelInstanceValue* value = instance->propertyValue(std::string(name));
+        if (!value)
+        {
+            return 0;
+        }
+
+        if (component->m_ViewModelProperties.Full())
+        {
+            component->m_ViewModelProperties.OffsetCapacity(16);
+        }
+        component->m_ViewModelProperties.Put(key, value);
+        return value;
+    }
+
+    static void PrewarmDraw(rive::Renderer* renderer, rive::ArtboardInstance* artboard, uint32_t width, uint32_t height)
+    {
+        renderer->save();
+        renderer->align(rive::Fit::contain,
+            rive::Alignment::center,
+            rive::AABB(0, 0, width, height),
+            artboard->bounds());
+        artboard->draw(renderer);
+        renderer->restore();
+    }
+
+    // The GPU programs are compiled when a combination of features (e.g. blend mode, clipping, gradients or image meshes)
+    // is drawn the first time. To get the compilation out of the way, every artboard of the file is drawn in its initial
+    // state, in a few frames of each animation and in the initial state of each state machine.
+    // The frame is drawn into the first offscreen target of the world, and is cleared when the world is drawn
+    void CompRivePrewarm(RiveComponent* component)
+    {
+        dmRive::RiveSceneData* data = (dmRive::RiveSceneData*) component->m_Resource->m_Scene->m_Scene;
+        if (data->m_Prewarmed)
+            return;
+        data->m_Prewarmed = 1;
+
+        // The tessellation renderer draws with the material of the component, which is compiled when it's loaded
+        RiveWorld* world = component->m_RiveWorld;
+        if (world->m_Tessellation)
+            return;
+
+        DM_PROFILE("RivePrewarm");
+        rive::File* file = data->m_File;
+
+        RenderBegin(world->m_RiveRenderContext, world->m_Ctx->m_Factory, 0);
+        rive::Renderer* renderer = GetRiveRenderer(world->m_RiveRenderContext);
+
+        uint32_t width, height;
+        GetDimensions(world->m_RiveRenderContext, &width, &height);
+
+        for (size_t i = 0; i < file->artboardCount(); ++i)
+        {
+            std::unique_ptr<rive::ArtboardInstance> artboard = file->artboardAt(i);
+            if (!artboard)
+                continue;
+
+            artboard->advance(0.0f);
+            PrewarmDraw(renderer, artboard.get(), width, height);
+
+            for (size_t j = 0; j < artboard->animationCount(); ++j)
+            {
+                std::unique_ptr<rive::LinearAnimationInstance> animation = artboard->animationAt(j);
+                float start    = animation->animation()->startSeconds();
+                float duration = animation->animation()->durationSeconds();
+                for (uint32_t k = 0; k < PREWARM_SAMPLE_COUNT; ++k)
+                {
+                    animation->time(start + duration * k / (PREWARM_SAMPLE_COUNT - 1));
+                    animation->apply();
+                    artboard->advance(0.0f);
+                    PrewarmDraw(renderer, artboard.get(), width, height);
+                }
+            }
+
+            for (size_t j = 0; j < artboard->stateMachineCount(); ++j)
+            {
+                std::unique_ptr<rive::StateMachineInstance> state_machine = artboard->stateMachineAt(j);
+                state_machine->advanceAndApply(0.0f);
+                PrewarmDraw(renderer, artboard.get(), width, height);
+            }
+        }
+
+        RenderEnd(world->m_RiveRenderContext);
+    }
+
+    void CompRiveSetTimeScale(RiveWorld* world, float time_scale)
+    {
+        world->m_TimeScale = time_scale;
+    }
+
+    void CompRiveSetFixedTimestep(RiveWorld* world, float step, uint32_t max_substeps)
+    {
+        world->m_FixedTimestep   = step;
+        world->m_MaxSubsteps     = dmMath::Max(1u, max_substeps);
+        world->m_TimeAccumulator = 0.0;
+    }
+
     bool CompRiveGetBoneID(RiveComponent* component, dmhash_t bone_name, dmhash_t* id)
     {
         uint32_t num_bones = component->m_Bones.Size();
@@ -1452,44 +2894,312 @@ namespace dmRive
         return false;
     }
 
-    static rive::Vec2D WorldToLocal(RiveComponent* component, float x, float y)
+    static rive::Vec2D WorldToLocal(RiveComponent* component, const Matrix4& world_inv, float x, float y)
     {
         float scale = g_DisplayFactor;
 
         rive::AABB bounds = component->m_ArtboardInstance->bounds();
-        Matrix4 world_inv = dmVMath::Inverse(component->m_World);
         Vector4 local = (world_inv * Point3(x*scale, y*scale, 0));
-        float bounds_width_half = bounds.width() * 0.5f;
-        float bounds_height_half = bounds.height() * 0.5f;
         rive::Vec2D p((local.getX() + bounds.width()) / scale, (bounds.height() - local.getY()) / scale);
         return p;
     }
 
-    void CompRivePointerMove(RiveComponent* component, float x, float y)
+    static rive::Vec2D WorldToLocal(RiveComponent* component, float x, float y)
     {
-        if (component->m_StateMachineInstance)
+        return WorldToLocal(component, dmVMath::Inverse(GetHot(component)->m_World), x, y);
+    }
+
+    static void QueuePointerEvent(RiveComponent* component, PointerEventType type, float x, float y, uint32_t pointer_id)
+    {
+        if (!component->m_StateMachineInstance)
+        {
+            return;
+        }
+
+        dmArray<RivePointerEvent>& events = component->m_PointerEvents;
+
+        // A move replaces the previous move of the same pointer, unless a press or release was queued after it
+        if (type == POINTER_EVENT_MOVE)
+        {
+            for (uint32_t i = events.Size(); i > 0; --i)
+            {
+                RivePointerEvent& event = events[i - 1];
+                if (event.m_Type != POINTER_EVENT_MOVE)
+                {
+                    break;
+                }
+                if (event.m_PointerId == pointer_id)
+                {
+                    event.m_X = x;
+                    event.m_Y = y;
+                    return;
+                }
+            }
+        }
+
+        if (events.Size() >= MAX_POINTER_EVENT_COUNT)
         {
-            rive::Vec2D p = WorldToLocal(component, x, y);
-            component->m_StateMachineInstance->pointerMove(p);
+            dmLogWarning("Too many pointer events queued for the rive model, the event is ignored");
+            return;
         }
+        if (events.Full())
+        {
+            events.OffsetCapacity(8);
+        }
+
+        RivePointerEvent event;
+        event.m_X         = x;
+        event.m_Y         = y;
+        event.m_PointerId = pointer_id;
+        event.m_Type      = (uint8_t)type;
+        events.Push(event);
+        component->m_RiveWorld->m_PointerEventCount++;
     }
 
-    void CompRivePointerUp(RiveComponent* component, float x, float y)
+    void CompRivePointerMove(RiveComponent* component, float x, float y, uint32_t pointer_id)
     {
-        if (component->m_StateMachineInstance)
+        QueuePointerEvent(component, POINTER_EVENT_MOVE, x, y, pointer_id);
+    }
+
+    void CompRivePointerUp(RiveComponent* component, float x, float y, uint32_t pointer_id)
+    {
+        QueuePointerEvent(component, POINTER_EVENT_UP, x, y, pointer_id);
+    }
+
+    void CompRivePointerDown(RiveComponent* component, float x, float y, uint32_t pointer_id)
+    {
+        QueuePointerEvent(component, POINTER_EVENT_DOWN, x, y, pointer_id);
+    }
+
+    static inline uint32_t GetPointerCell(float v, float min, float cell_size, uint32_t grid_size)
+    {
+        int cell = (int)((v - min) / cell_size);
+        return (uint32_t)dmMath::Clamp(cell, 0, (int)grid_size - 1);
+    }
+
+    // Collects the bounds and inverse transforms of the components, and sorts them into a uniform grid,
+    // so that a pointer event only has to visit the components in the cell under the pointer
+    static void UpdatePointerIndex(RiveWorld* world)
+    {
+        DM_PROFILE("UpdatePointerIndex");
+
+        world->m_PointerIndexDirty = 0;
+        world->m_PointerTargets.SetSize(0);
+        world->m_PointerGridSize = 0;
+
+        float scale = g_DisplayFactor;
+        float grid_min_x = FLT_MAX;
+        float grid_min_y = FLT_MAX;
+        float grid_max_x = -FLT_MAX;
+        float grid_max_y = -FLT_MAX;
+
+        dmArray<RiveComponentHot>& components = world->m_Components.GetRawObjects();
+        uint32_t count = components.Size();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            RiveComponentHot& hot = components[i];
+            RiveComponent* component = hot.m_Component;
+            if (!hot.m_Enabled || !hot.m_AddedToUpdate || !component->m_ArtboardInstance)
+                continue;
+
+            // The artboard rectangle in component space, as mapped by WorldToLocal()
+            rive::AABB bounds = component->m_ArtboardInstance->bounds();
+            float w = bounds.width();
+            float h = bounds.height();
+            float local_x[2] = { bounds.minX * scale - w, bounds.maxX * scale - w };
+            float local_y[2] = { h - bounds.maxY * scale, h - bounds.minY * scale };
+
+            RivePointerTarget target;
+            target.m_MinX = FLT_MAX;
+            target.m_MinY = FLT_MAX;
+            target.m_MaxX = -FLT_MAX;
+            target.m_MaxY = -FLT_MAX;
+            for (uint32_t corner = 0; corner < 4; ++corner)
+            {
+                Vector4 p = hot.m_World * Point3(local_x[corner & 1], local_y[corner >> 1], 0.0f);
+                float x = p.getX() / scale;
+                float y = p.getY() / scale;
+                target.m_MinX = dmMath::Min(target.m_MinX, x);
+                target.m_MinY = dmMath::Min(target.m_MinY, y);
+                target.m_MaxX = dmMath::Max(target.m_MaxX, x);
+                target.m_MaxY = dmMath::Max(target.m_MaxY, y);
+            }
+            target.m_WorldInverse = dmVMath::Inverse(hot.m_World);
+            target.m_Component    = component;
+
+            grid_min_x = dmMath::Min(grid_min_x, target.m_MinX);
+            grid_min_y = dmMath::Min(grid_min_y, target.m_MinY);
+            grid_max_x = dmMath::Max(grid_max_x, target.m_MaxX);
+            grid_max_y = dmMath::Max(grid_max_y, target.m_MaxY);
+
+            if (world->m_PointerTargets.Full())
+                world->m_PointerTargets.OffsetCapacity(16);
+            world->m_PointerTargets.Push(target);
+        }
+
+        uint32_t target_count = world->m_PointerTargets.Size();
+        if (target_count == 0)
+            return;
+
+        uint32_t grid_size = dmMath::Clamp((uint32_t)sqrtf((float)target_count), 1u, MAX_POINTER_GRID_SIZE);
+        uint32_t cell_count = grid_size * grid_size;
+        world->m_PointerGridSize   = grid_size;
+        world->m_PointerGridMinX   = grid_min_x;
+        world->m_PointerGridMinY   = grid_min_y;
+        world->m_PointerCellWidth  = dmMath::Max((grid_max_x - grid_min_x) / grid_size, FLT_EPSILON);
+        world->m_PointerCellHeight = dmMath::Max((grid_max_y - grid_min_y) / grid_size, FLT_EPSILON);
+
+        // Count the targets overlapping each cell
+        if (world->m_PointerCells.Capacity() < cell_count + 1)
+            world->m_PointerCells.SetCapacity(cell_count + 1);
+        world->m_PointerCells.SetSize(cell_count + 1);
+        memset(world->m_PointerCells.Begin(), 0, sizeof(uint32_t) * (cell_count + 1));
+
+        uint32_t item_count = 0;
+        for (uint32_t i = 0; i < target_count; ++i)
+        {
+            const RivePointerTarget& target = world->m_PointerTargets[i];
+            uint32_t x0 = GetPointerCell(target.m_MinX, grid_min_x, world->m_PointerCellWidth, grid_size);
+            uint32_t x1 = GetPointerCell(target.m_MaxX, grid_min_x, world->m_PointerCellWidth, grid_size);
+            uint32_t y0 = GetPointerCell(target.m_MinY, grid_min_y, world->m_PointerCellHeight, grid_size);
+            uint32_t y1 = GetPointerCell(target.m_MaxY, grid_min_y, world->m_PointerCellHeight, grid_size);
+            for (uint32_t y = y0; y <= y1; ++y)
+            {
+                for (uint32_t x = x0; x <= x1; ++x)
+                {
+                    world->m_PointerCells[y * grid_size + x]++;
+                    item_count++;
+                }
+            }
+        }
+
+        // Make each count the end of the cell, and then fill the cells backwards, which leaves the start of each cell
+        uint32_t end = 0;
+        for (uint32_t i = 0; i < cell_count; ++i)
         {
-            rive::Vec2D p = WorldToLocal(component, x, y);
-            component->m_StateMachineInstance->pointerUp(p);
+            end += world->m_PointerCells[i];
+            world->m_PointerCells[i] = end;
+        }
+        world->m_PointerCells[cell_count] = item_count;
+
+        if (world->m_PointerCellItems.Capacity() < item_count)
+            world->m_PointerCellItems.SetCapacity(item_count);
+        world->m_PointerCellItems.SetSize(item_count);
+
+        for (uint32_t i = 0; i < target_count; ++i)
+        {
+            const RivePointerTarget& target = world->m_PointerTargets[i];
+            uint32_t x0 = GetPointerCell(target.m_MinX, grid_min_x, world->m_PointerCellWidth, grid_size);
+            uint32_t x1 = GetPointerCell(target.m_MaxX, grid_min_x, world->m_PointerCellWidth, grid_size);
+            uint32_t y0 = GetPointerCell(target.m_MinY, grid_min_y, world->m_PointerCellHeight, grid_size);
+            uint32_t y1 = GetPointerCell(target.m_MaxY, grid_min_y, world->m_PointerCellHeight, grid_size);
+            for (uint32_t y = y0; y <= y1; ++y)
+            {
+                for (uint32_t x = x0; x <= x1; ++x)
+                {
+                    world->m_PointerCellItems[--world->m_PointerCells[y * grid_size + x]] = i;
+                }
+            }
+        }
+    }
+
+    static rive::HitResult SendPointerEvent(rive::StateMachineInstance* state_machine, PointerEventType type, rive::Vec2D p)
+    {
+        switch (type)
+        {
+            case POINTER_EVENT_DOWN:    return state_machine->pointerDown(p);
+            case POINTER_EVENT_UP:      return state_machine->pointerUp(p);
+            default:                    return state_machine->pointerMove(p);
         }
     }
 
-    void CompRivePointerDown(RiveComponent* component, float x, float y)
+    static void FlushPointerEvents(RiveComponentHot* hot)
     {
+        RiveComponent* component = hot->m_Component;
+        dmArray<RivePointerEvent>& events = component->m_PointerEvents;
+
+        // The state machine may have been replaced since the events were queued
         if (component->m_StateMachineInstance)
         {
-            rive::Vec2D p = WorldToLocal(component, x, y);
-            component->m_StateMachineInstance->pointerDown(p);
+            // Same for all events, as the transforms don't change until the next render
+            Matrix4 world_inv = dmVMath::Inverse(hot->m_World);
+            for (uint32_t i = 0; i < events.Size(); ++i)
+            {
+                const RivePointerEvent& event = events[i];
+                rive::Vec2D p = WorldToLocal(component, world_inv, event.m_X, event.m_Y);
+                SendPointerEvent(component->m_StateMachineInstance.get(), (PointerEventType)event.m_Type, p);
+            }
+        }
+        component->m_RiveWorld->m_PointerEventCount -= events.Size();
+        events.SetSize(0);
+    }
+
+    bool CompRiveWorldPointerEvent(RiveWorld* world, PointerEventType type, float x, float y)
+    {
+        DM_PROFILE("RivePointerEvent");
+        WaitForAdvance(world);
+
+        if (world->m_PointerIndexDirty)
+        {
+            UpdatePointerIndex(world);
+        }
+
+        bool hit = false;
+        world->m_PointerHoveredNext.SetSize(0);
+
+        uint32_t grid_size = world->m_PointerGridSize;
+        if (grid_size > 0)
+        {
+            float grid_max_x = world->m_PointerGridMinX + world->m_PointerCellWidth * grid_size;
+            float grid_max_y = world->m_PointerGridMinY + world->m_PointerCellHeight * grid_size;
+            if (x >= world->m_PointerGridMinX && x <= grid_max_x && y >= world->m_PointerGridMinY && y <= grid_max_y)
+            {
+                uint32_t cell = GetPointerCell(y, world->m_PointerGridMinY, world->m_PointerCellHeight, grid_size) * grid_size
+                              + GetPointerCell(x, world->m_PointerGridMinX, world->m_PointerCellWidth, grid_size);
+                uint32_t begin = world->m_PointerCells[cell];
+                uint32_t end   = world->m_PointerCells[cell + 1];
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    const RivePointerTarget& target = world->m_PointerTargets[world->m_PointerCellItems[i]];
+                    if (x < target.m_MinX || x > target.m_MaxX || y < target.m_MinY || y > target.m_MaxY)
+                        continue;
+
+                    RiveComponent* component = target.m_Component;
+                    if (!component->m_StateMachineInstance)
+                        continue;
+
+                    rive::Vec2D p = WorldToLocal(component, target.m_WorldInverse, x, y);
+                    hit |= SendPointerEvent(component->m_StateMachineInstance.get(), type, p) != rive::HitResult::none;
+
+                    if (type == POINTER_EVENT_MOVE)
+                    {
+                        if (world->m_PointerHoveredNext.Full())
+                            world->m_PointerHoveredNext.OffsetCapacity(8);
+                        world->m_PointerHoveredNext.Push(component);
+                    }
+                }
+            }
+        }
+
+        if (type == POINTER_EVENT_MOVE)
+        {
+            // The components the pointer has left get an exit event, so that their hover states are reset
+            for (uint32_t i = 0; i < world->m_PointerHovered.Size(); ++i)
+            {
+                RiveComponent* component = world->m_PointerHovered[i];
+                bool hovered = false;
+                for (uint32_t j = 0; j < world->m_PointerHoveredNext.Size(); ++j)
+                {
+                    hovered |= world->m_PointerHoveredNext[j] == component;
+                }
+                if (!hovered && component->m_StateMachineInstance)
+                {
+                    component->m_StateMachineInstance->pointerExit(WorldToLocal(component, x, y));
+                }
+            }
+            world->m_PointerHovered.Swap(world->m_PointerHoveredNext);
         }
+        return hit;
     }
 }
 
@@ -16,18 +16,25 @@
 #include <stdint.h>
 #include <dmsdk/script.h>
 #include <dmsdk/dlib/hash.h>
+#include <dmsdk/dlib/hashtable.h>
 #include <dmsdk/dlib/vmath.h>
 #include <dmsdk/dlib/transform.h>
 #include <dmsdk/gameobject/gameobject.h>
 #include <dmsdk/gamesys/render_constants.h>
 
 #include "rive_ddf.h"
+#include "block_pool.h"
 
 namespace rive
 {
+    class File;
     class StateMachineInstance;
     class LinearAnimationInstance;
     class Bone;
+    class Event;
+    class TextValueRun;
+    class ViewModelInstance;
+    class ViewModelInstanceValue;
 }
 
 namespace dmRive
@@ -36,13 +43,59 @@ namespace dmRive
 
     struct RiveModelResource;
     struct RiveBuffer;
+    struct RiveWorld;
+    struct RiveComponentChunk;
+    struct BakedAnimation;
+
+    // Destroys an instance allocated from one of the world pools
+    struct RivePoolDeleter
+    {
+        BlockPool* m_Pool;
+
+        template<typename T>
+        void operator()(T* instance) const
+        {
+            instance->~T();
+            BlockPoolFree(m_Pool, instance);
+        }
+    };
+
+    typedef std::unique_ptr<rive::LinearAnimationInstance, RivePoolDeleter> RiveAnimationInstancePtr;
+    typedef std::unique_ptr<rive::StateMachineInstance, RivePoolDeleter>    RiveStateMachineInstancePtr;
+
+    // An animation that is being faded out
+    struct RiveAnimationLayer
+    {
+        rive::LinearAnimationInstance*  m_Instance; // Allocated from the world pool
+        float                           m_Mix;      // The mix the animation had when it was replaced
+    };
+
+    // A pointer event, waiting for the next update
+    struct RivePointerEvent
+    {
+        float                           m_X;
+        float                           m_Y;
+        uint32_t                        m_PointerId;
+        uint8_t                         m_Type; // PointerEventType
+    };
+
+    // A game object that follows a bone
+    struct RiveBoneAttachment
+    {
+        rive::Bone*                     m_Bone;
+        dmhash_t                        m_BoneName;
+        dmhash_t                        m_InstanceId;
+    };
 
     // Keep this private from the scripting api
+    // The data used by the update and render loops (e.g. the world transform and the enabled flags)
+    // is stored separately, see RiveComponentHot in comp_rive.cpp
     struct RiveComponent
     {
         dmGameObject::HInstance                 m_Instance;
-        dmTransform::Transform                  m_Transform;
-        dmVMath::Matrix4                        m_World;
+        RiveWorld*                              m_RiveWorld;
+        uint32_t                                m_Index;    // Index of the hot data in the world
+        RiveComponentChunk*                     m_Chunk;    // The storage of the component in the world
         RiveModelResource*                      m_Resource;
         dmMessage::URL                          m_Listener;
         dmGameSystem::HComponentRenderConstants m_RenderConstants;
@@ -50,36 +103,83 @@ namespace dmRive
         dmScript::LuaCallbackInfo*              m_Callback;
         uint32_t                                m_CallbackId;
 
+        rive::File*                                     m_File; // The file the artboard instance was created from
         std::unique_ptr<rive::ArtboardInstance>         m_ArtboardInstance;
-        std::unique_ptr<rive::LinearAnimationInstance>  m_AnimationInstance;
-        std::unique_ptr<rive::StateMachineInstance>     m_StateMachineInstance;
+        RiveAnimationInstancePtr                        m_AnimationInstance;
+        const BakedAnimation*                           m_BakedAnimation; // If set, used to apply m_AnimationInstance
+        RiveStateMachineInstancePtr                     m_StateMachineInstance;
+        std::unique_ptr<rive::ViewModelInstance>        m_ViewModelInstance; // Bound to the artboard, if it has a view model
 
+        dmArray<RiveAnimationLayer>             m_AnimationLayers; // Previous animations, oldest first, applied before m_AnimationInstance
         dmGameObject::Playback                  m_AnimationPlayback;
         float                                   m_AnimationPlaybackRate;
+        float                                   m_AnimationMix;         // The weight of m_AnimationInstance on top of the fading animations
+        float                                   m_AnimationCrossfadeTime;
 
         dmArray<rive::Bone*>                    m_Bones;
         dmArray<dmGameObject::HInstance>        m_BoneGOs;
+        dmArray<float>                          m_BoneTransforms; // SoA: x, y, rotation z, rotation w for the last written and the new bone transforms
         dmArray<dmhash_t>                       m_StateMachineInputs; // A list of the hashed names for the state machine inputs. Index corresponds 1:1 to the statemachine inputs
+        dmHashTable64<rive::TextValueRun*>      m_TextRuns; // Text runs that have been looked up by name
+        dmHashTable64<rive::Bone*>              m_NamedBones; // Bones that have been looked up by name
+        dmArray<RiveBoneAttachment>             m_BoneAttachments; // Game objects following bones. Updated each frame
+        dmArray<RivePointerEvent>               m_PointerEvents; // Sent to the state machine in the next update
+        dmArray<rive::Event*>                   m_ReportedEvents; // Reported by the state machine during the advance, sent after it
+        dmHashTable64<rive::ViewModelInstanceValue*> m_ViewModelProperties; // Properties of m_ViewModelInstance that have been looked up by name
 
         uint32_t                                m_VertexCount;
         uint32_t                                m_IndexCount;
-        uint32_t                                m_MixedHash;
+        uint32_t                                m_InstanceBytes; // Estimated memory used by m_ArtboardInstance, see EstimateArtboardInstanceBytes()
         uint16_t                                m_ComponentIndex;
         uint8_t                                 m_AnimationIndex;
-        uint8_t                                 m_Enabled : 1;
-        uint8_t                                 m_DoRender : 1;
-        uint8_t                                 m_AddedToUpdate : 1;
-        uint8_t                                 m_ReHash : 1;
+        uint8_t                                 m_AnimationFinished; // The animation finished during the advance, reset after it
     };
 
     // For scripting
 
     // Get the game object identifier
     bool CompRiveGetBoneID(RiveComponent* component, dmhash_t bone_name, dmhash_t* id);
+
+    // Get the world transform of a bone. Returns false if the bone wasn't found
+    bool CompRiveGetBoneTransform(RiveComponent* component, dmhash_t bone_name, dmVMath::Point3* position, dmVMath::Quat* rotation);
+
+    // Make a game object in the same collection follow a bone. Returns false if the bone wasn't found
+    bool CompRiveAttachToBone(RiveComponent* component, dmhash_t bone_name, dmhash_t instance_id);
+    void CompRiveDetachFromBone(RiveComponent* component, dmhash_t instance_id);
+
+    // Set the text of a text run. Returns false if the text run wasn't found
+    bool CompRiveSetTextRun(RiveComponent* component, dmhash_t name_hash, const char* text);
+
+    // Compile the GPU programs needed to draw the rive file of the component, by drawing all its artboards offscreen.
+    // Only the first call per file does any work
+    void CompRivePrewarm(RiveComponent* component);
+
+    // Wait for the components of all worlds being advanced on the worker threads (see rive.pipelined_update)
+    void CompRiveWaitForAdvances();
+
+    // Set the time scale of all components in the world. A time scale of 0 pauses the world
+    void CompRiveSetTimeScale(RiveWorld* world, float time_scale);
+
+    // Set the fixed timestep of the world. A step of 0 means the variable frame time is used
+    void CompRiveSetFixedTimestep(RiveWorld* world, float step, uint32_t max_substeps);
+
+    // Get a property of the view model instance (or one of its nested instances). Returns 0 if the property wasn't found
+    rive::ViewModelInstanceValue* CompRiveGetViewModelProperty(RiveComponent* component, rive::ViewModelInstance* instance, const char* name);
     
-    void CompRivePointerMove(RiveComponent* component, float x, float y);
-    void CompRivePointerUp(RiveComponent* component, float x, float y);
-    void CompRivePointerDown(RiveComponent* component, float x, float y);
+    enum PointerEventType
+    {
+        POINTER_EVENT_MOVE,
+        POINTER_EVENT_DOWN,
+        POINTER_EVENT_UP,
+    };
+
+    // Send a pointer event to all components in the world under the pointer. Returns true if a listener was hit
+    bool CompRiveWorldPointerEvent(RiveWorld* world, PointerEventType type, float x, float y);
+
+    // Queue pointer events for the next update. Moves of the same pointer are merged
+    void CompRivePointerMove(RiveComponent* component, float x, float y, uint32_t pointer_id);
+    void CompRivePointerUp(RiveComponent* component, float x, float y, uint32_t pointer_id);
+    void CompRivePointerDown(RiveComponent* component, float x, float y, uint32_t pointer_id);
 
     bool CompRivePlayStateMachine(RiveComponent* component, dmRiveDDF::RivePlayAnimation* ddf, dmScript::LuaCallbackInfo* callback_info);
     bool CompRivePlayAnimation(RiveComponent* component, dmRiveDDF::RivePlayAnimation* ddf, dmScript::LuaCallbackInfo* callback_info);
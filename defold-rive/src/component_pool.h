@@ -0,0 +1,139 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef DM_RIVE_COMPONENT_POOL_H
+#define DM_RIVE_COMPONENT_POOL_H
+
+#include <stdint.h>
+#include <dmsdk/dlib/array.h>
+#include <dmsdk/dlib/math.h>
+
+namespace dmRive
+{
+    // Densely stored objects, referenced by stable indices (like dmObjectPool).
+    // The storage grows geometrically, and shrinks when most of it is unused.
+    // The objects move when the pool grows, shrinks or when an object is freed
+    template<typename T>
+    class ComponentPool
+    {
+    public:
+        static const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+        static const uint32_t MIN_CAPACITY  = 16;
+
+        uint32_t Alloc(const T& object)
+        {
+            uint32_t index = INVALID_INDEX;
+            while (!m_FreeIndices.Empty())
+            {
+                uint32_t free_index = m_FreeIndices.Back();
+                m_FreeIndices.Pop();
+                // Indices at the end are released when freed, so the free list may hold stale entries
+                if (free_index < m_Slots.Size() && m_Slots[free_index] == INVALID_INDEX)
+                {
+                    index = free_index;
+                    break;
+                }
+            }
+
+            if (index == INVALID_INDEX)
+            {
+                Reserve(m_Slots, m_Slots.Size() + 1);
+                index = m_Slots.Size();
+                m_Slots.Push(INVALID_INDEX);
+            }
+
+            Reserve(m_Objects, m_Objects.Size() + 1);
+            Reserve(m_Indices, m_Indices.Size() + 1);
+            m_Slots[index] = m_Objects.Size();
+            m_Objects.Push(object);
+            m_Indices.Push(index);
+            return index;
+        }
+
+        void Free(uint32_t index)
+        {
+            uint32_t slot = m_Slots[index];
+            uint32_t last = m_Objects.Size() - 1;
+            if (slot != last)
+            {
+                m_Objects[slot] = m_Objects[last];
+                m_Indices[slot] = m_Indices[last];
+                m_Slots[m_Indices[slot]] = slot;
+            }
+            m_Objects.Pop();
+            m_Indices.Pop();
+            m_Slots[index] = INVALID_INDEX;
+
+            if (index == m_Slots.Size() - 1)
+            {
+                while (!m_Slots.Empty() && m_Slots.Back() == INVALID_INDEX)
+                    m_Slots.Pop();
+            }
+            else
+            {
+                if (m_FreeIndices.Full())
+                    m_FreeIndices.OffsetCapacity(dmMath::Max(MIN_CAPACITY, m_FreeIndices.Capacity()));
+                m_FreeIndices.Push(index);
+            }
+
+            Shrink(m_Objects);
+            Shrink(m_Indices);
+            Shrink(m_Slots);
+            if (m_FreeIndices.Size() > m_Slots.Size())
+            {
+                // Only stale entries are left
+                m_FreeIndices.SetSize(0);
+            }
+            Shrink(m_FreeIndices);
+        }
+
+        T& Get(uint32_t index)
+        {
+            return m_Objects[m_Slots[index]];
+        }
+
+        dmArray<T>& GetRawObjects()
+        {
+            return m_Objects;
+        }
+
+        uint32_t Size() const
+        {
+            return m_Objects.Size();
+        }
+
+    private:
+        template<typename U>
+        static void Reserve(dmArray<U>& array, uint32_t size)
+        {
+            if (array.Capacity() < size)
+                array.SetCapacity(dmMath::Max(MIN_CAPACITY, dmMath::Max(size, array.Capacity() * 2)));
+        }
+
+        // Halves the capacity when less than a quarter of it is used, so that adding and removing
+        // an object at the boundary doesn't reallocate each time
+        template<typename U>
+        static void Shrink(dmArray<U>& array)
+        {
+            uint32_t capacity = array.Capacity();
+            if (capacity > MIN_CAPACITY && array.Size() < capacity / 4)
+                array.SetCapacity(dmMath::Max(MIN_CAPACITY, capacity / 2));
+        }
+
+        dmArray<T>          m_Objects;      // Dense
+        dmArray<uint32_t>   m_Indices;      // The index of each object
+        dmArray<uint32_t>   m_Slots;        // Per index, the position of the object in m_Objects, or INVALID_INDEX
+        dmArray<uint32_t>   m_FreeIndices;
+    };
+}
+
+#endif // DM_RIVE_COMPONENT_POOL_H
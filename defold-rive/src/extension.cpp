@@ -1,9 +1,35 @@
 
 #include <dmsdk/sdk.h>
+#include <dmsdk/dlib/sys.h>
+#include <string.h> // strcmp
 #include "script_rive.h"
 
+#if !defined(DM_RIVE_UNSUPPORTED)
+#include "renderer.h"
+#endif
+
 static dmExtension::Result AppInitializeRive(dmExtension::AppParams* params)
 {
+#if !defined(DM_RIVE_UNSUPPORTED)
+    const char* renderer = dmConfigFile::GetString(params->m_ConfigFile, "rive.renderer", "default");
+    if (strcmp(renderer, "tessellation") == 0)
+    {
+        dmRive::SetRendererType(dmRive::RENDERER_TYPE_TESSELLATION);
+    }
+
+    // The renderer is created when the first rive resource type is registered, so this is read before the component type is
+    if (dmConfigFile::GetInt(params->m_ConfigFile, "rive.program_cache", 0))
+    {
+        const char* title = dmConfigFile::GetString(params->m_ConfigFile, "project.title", "defold");
+        char dir[1024];
+        if (dmSys::GetApplicationSupportPath(title, dir, sizeof(dir)) == dmSys::RESULT_OK)
+        {
+            char path[1024];
+            dmSnPrintf(path, sizeof(path), "%s/rive_programs.bin", dir);
+            dmRive::SetProgramCachePath(path);
+        }
+    }
+#endif
     return dmExtension::RESULT_OK;
 }
 
@@ -0,0 +1,458 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#if defined(DM_RIVE_USE_OPENGL) && defined(RIVE_DESKTOP_GL)
+
+// Caches the linked GL programs on disk, so that the programs of the Rive renderer aren't compiled on each launch.
+// The renderer library compiles its programs itself, so the cache hooks into the GL calls it makes, by swapping the
+// function pointers loaded by glad:
+//   * glCompileShader is deferred, until the shader is queried or a program using it has to be linked
+//   * glLinkProgram first looks for a binary of the same sources (and attribute bindings) and loads it with glProgramBinary
+// The binaries are only valid for the same driver, so the cache is discarded when the driver changes.
+//
+// NOTE: This only works where glad loads the GL functions. On Android (and HTML5) the renderer library links
+// directly against the system GLES library, so there are no pointers to swap, and the programs are compiled as before.
+// Supporting those platforms isn't a goal of this cache.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dmsdk/dlib/dstrings.h>
+#include <dmsdk/dlib/hash.h>
+#include <dmsdk/dlib/hashtable.h>
+#include <dmsdk/dlib/log.h>
+
+#include <rive/renderer/gl/gles3.hpp>
+
+#include "renderer_context.h"
+
+namespace dmRive
+{
+    static const uint32_t PROGRAM_CACHE_MAGIC   = 0x52505243; // "RPRC"
+    static const uint32_t PROGRAM_CACHE_VERSION = 1;
+    static const uint32_t MAX_PROGRAM_BINARY_SIZE = 16 * 1024 * 1024; // Anything larger is a corrupt entry
+
+    struct ProgramCacheHeader
+    {
+        uint32_t m_Magic;
+        uint32_t m_Version;
+        uint64_t m_DriverHash;
+    };
+
+    // Followed by m_Size bytes of program binary
+    struct ProgramCacheEntryHeader
+    {
+        uint64_t m_Key;
+        uint32_t m_Format;
+        uint32_t m_Size;
+    };
+
+    struct CachedProgram
+    {
+        uint8_t* m_Data;
+        uint32_t m_Format;
+        uint32_t m_Size;
+    };
+
+    struct ProgramCache
+    {
+        char                            m_Path[1024];
+        uint64_t                        m_DriverHash;
+        dmHashTable64<CachedProgram>    m_Programs;       // By program key
+        dmHashTable32<dmhash_t>         m_ShaderKeys;     // Hash of the sources, by shader
+        dmHashTable32<dmhash_t>         m_ProgramKeys;    // Hash of the attached shaders and the attribute bindings, by program
+        dmHashTable32<uint8_t>          m_PendingShaders; // Shaders that haven't been compiled yet
+        uint8_t                         m_FileValid : 1;  // The file on disk has a header for the current driver
+
+        PFNGLSHADERSOURCEPROC           m_ShaderSource;
+        PFNGLCOMPILESHADERPROC          m_CompileShader;
+        PFNGLGETSHADERIVPROC            m_GetShaderiv;
+        PFNGLGETSHADERINFOLOGPROC       m_GetShaderInfoLog;
+        PFNGLDELETESHADERPROC           m_DeleteShader;
+        PFNGLATTACHSHADERPROC           m_AttachShader;
+        PFNGLBINDATTRIBLOCATIONPROC     m_BindAttribLocation;
+        PFNGLLINKPROGRAMPROC            m_LinkProgram;
+        PFNGLDELETEPROGRAMPROC          m_DeleteProgram;
+    };
+
+    static ProgramCache* g_ProgramCache = 0;
+
+    template <typename KEY, typename T>
+    static void PutGrow(dmHashTable<KEY, T>& table, KEY key, const T& value)
+    {
+        if (table.Full())
+        {
+            table.OffsetCapacity(64);
+        }
+        table.Put(key, value);
+    }
+
+    static dmhash_t CombineKey(dmhash_t key, const void* data, uint32_t size)
+    {
+        HashState64 state;
+        dmHashInit64(&state, false);
+        dmHashUpdateBuffer64(&state, &key, sizeof(key));
+        dmHashUpdateBuffer64(&state, data, size);
+        return dmHashFinal64(&state);
+    }
+
+    static void WriteHeader(ProgramCache* cache, FILE* file)
+    {
+        ProgramCacheHeader header;
+        header.m_Magic      = PROGRAM_CACHE_MAGIC;
+        header.m_Version    = PROGRAM_CACHE_VERSION;
+        header.m_DriverHash = cache->m_DriverHash;
+        fwrite(&header, sizeof(header), 1, file);
+    }
+
+    static void WriteEntry(FILE* file, dmhash_t key, const CachedProgram& program)
+    {
+        ProgramCacheEntryHeader entry;
+        entry.m_Key    = key;
+        entry.m_Format = program.m_Format;
+        entry.m_Size   = program.m_Size;
+        fwrite(&entry, sizeof(entry), 1, file);
+        fwrite(program.m_Data, 1, program.m_Size, file);
+    }
+
+    static void WriteEntryCallback(FILE* file, const uint64_t* key, CachedProgram* program)
+    {
+        WriteEntry(file, *key, *program);
+    }
+
+    // Rewrites the file with only the programs in the cache
+    static void CompactProgramCache(ProgramCache* cache)
+    {
+        FILE* file = fopen(cache->m_Path, "wb");
+        if (!file)
+        {
+            dmLogWarning("Failed to write the program cache '%s'", cache->m_Path);
+            cache->m_FileValid = 0;
+            return;
+        }
+        WriteHeader(cache, file);
+        cache->m_Programs.Iterate(WriteEntryCallback, file);
+        fclose(file);
+        cache->m_FileValid = 1;
+    }
+
+    static void LoadProgramCache(ProgramCache* cache)
+    {
+        FILE* file = fopen(cache->m_Path, "rb");
+        if (!file)
+            return;
+
+        fseek(file, 0, SEEK_END);
+        long file_size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        ProgramCacheHeader header;
+        if (fread(&header, sizeof(header), 1, file) != 1 ||
+            header.m_Magic != PROGRAM_CACHE_MAGIC ||
+            header.m_Version != PROGRAM_CACHE_VERSION ||
+            header.m_DriverHash != cache->m_DriverHash)
+        {
+            // Written by another driver (or version), and will be overwritten
+            fclose(file);
+            return;
+        }
+
+        // A program that is relinked (e.g. when the driver rejected the binary) is appended again,
+        // and the file is rewritten without the stale entries
+        bool compact = false;
+        ProgramCacheEntryHeader entry;
+        while (fread(&entry, sizeof(entry), 1, file) == 1)
+        {
+            long remaining = file_size - ftell(file);
+            if (entry.m_Size == 0 || entry.m_Size > MAX_PROGRAM_BINARY_SIZE || (long) entry.m_Size > remaining)
+            {
+                // Truncated (e.g. if the app was killed while writing) or corrupt
+                compact = true;
+                break;
+            }
+
+            CachedProgram program;
+            program.m_Data   = (uint8_t*) malloc(entry.m_Size);
+            program.m_Format = entry.m_Format;
+            program.m_Size   = entry.m_Size;
+            if (!program.m_Data)
+            {
+                break;
+            }
+            if (fread(program.m_Data, 1, entry.m_Size, file) != entry.m_Size)
+            {
+                free(program.m_Data);
+                compact = true;
+                break;
+            }
+
+            CachedProgram* previous = cache->m_Programs.Get(entry.m_Key);
+            if (previous)
+            {
+                free(previous->m_Data);
+                compact = true;
+            }
+            PutGrow(cache->m_Programs, (uint64_t) entry.m_Key, program);
+        }
+        fclose(file);
+        cache->m_FileValid = 1;
+
+        if (compact)
+        {
+            CompactProgramCache(cache);
+        }
+    }
+
+    static void WriteProgram(ProgramCache* cache, dmhash_t key, const CachedProgram& program)
+    {
+        FILE* file = fopen(cache->m_Path, cache->m_FileValid ? "ab" : "wb");
+        if (!file)
+        {
+            dmLogWarning("Failed to write the program cache '%s'", cache->m_Path);
+            return;
+        }
+
+        if (!cache->m_FileValid)
+        {
+            WriteHeader(cache, file);
+            cache->m_FileValid = 1;
+        }
+        WriteEntry(file, key, program);
+        fclose(file);
+    }
+
+    static void CompilePendingShader(GLuint shader)
+    {
+        if (g_ProgramCache->m_PendingShaders.Get(shader))
+        {
+            g_ProgramCache->m_PendingShaders.Erase(shader);
+            g_ProgramCache->m_CompileShader(shader);
+        }
+    }
+
+    static void APIENTRY HookShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+    {
+        g_ProgramCache->m_ShaderSource(shader, count, strings, lengths);
+
+        HashState64 state;
+        dmHashInit64(&state, false);
+        for (GLsizei i = 0; i < count; ++i)
+        {
+            uint32_t length = (lengths && lengths[i] >= 0) ? (uint32_t) lengths[i] : (uint32_t) strlen(strings[i]);
+            dmHashUpdateBuffer64(&state, strings[i], length);
+        }
+        PutGrow(g_ProgramCache->m_ShaderKeys, shader, dmHashFinal64(&state));
+    }
+
+    static void APIENTRY HookCompileShader(GLuint shader)
+    {
+        PutGrow(g_ProgramCache->m_PendingShaders, shader, (uint8_t) 1);
+    }
+
+    static void APIENTRY HookGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+    {
+        CompilePendingShader(shader);
+        g_ProgramCache->m_GetShaderiv(shader, pname, params);
+    }
+
+    static void APIENTRY HookGetShaderInfoLog(GLuint shader, GLsizei size, GLsizei* length, GLchar* log)
+    {
+        CompilePendingShader(shader);
+        g_ProgramCache->m_GetShaderInfoLog(shader, size, length, log);
+    }
+
+    // Forgets a pending shader once the driver has released it, so that a reused name isn't compiled by mistake
+    static void ErasePendingShader(GLuint shader)
+    {
+        if (g_ProgramCache->m_PendingShaders.Get(shader) && !glad_glIsShader(shader))
+        {
+            g_ProgramCache->m_PendingShaders.Erase(shader);
+        }
+    }
+
+    static void APIENTRY HookDeleteShader(GLuint shader)
+    {
+        g_ProgramCache->m_ShaderKeys.Erase(shader);
+        g_ProgramCache->m_DeleteShader(shader);
+
+        // An attached shader lives on until the program is deleted, so it stays pending in case the program has to be linked.
+        // It is then erased in HookDeleteProgram()
+        ErasePendingShader(shader);
+    }
+
+    static void APIENTRY HookAttachShader(GLuint program, GLuint shader)
+    {
+        g_ProgramCache->m_AttachShader(program, shader);
+
+        dmhash_t* shader_key  = g_ProgramCache->m_ShaderKeys.Get(shader);
+        dmhash_t* program_key = g_ProgramCache->m_ProgramKeys.Get(program);
+        dmhash_t key = program_key ? *program_key : g_ProgramCache->m_DriverHash;
+        dmhash_t source = shader_key ? *shader_key : 0;
+        PutGrow(g_ProgramCache->m_ProgramKeys, program, CombineKey(key, &source, sizeof(source)));
+    }
+
+    static void APIENTRY HookBindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+    {
+        g_ProgramCache->m_BindAttribLocation(program, index, name);
+
+        dmhash_t* program_key = g_ProgramCache->m_ProgramKeys.Get(program);
+        dmhash_t key = CombineKey(program_key ? *program_key : g_ProgramCache->m_DriverHash, &index, sizeof(index));
+        PutGrow(g_ProgramCache->m_ProgramKeys, program, CombineKey(key, name, strlen(name)));
+    }
+
+    static void APIENTRY HookLinkProgram(GLuint program)
+    {
+        ProgramCache* cache = g_ProgramCache;
+
+        GLuint shaders[8];
+        GLsizei shader_count = 0;
+        glad_glGetAttachedShaders(program, sizeof(shaders) / sizeof(shaders[0]), &shader_count, shaders);
+
+        dmhash_t* program_key = cache->m_ProgramKeys.Get(program);
+        if (!program_key)
+        {
+            for (GLsizei i = 0; i < shader_count; ++i)
+                CompilePendingShader(shaders[i]);
+            cache->m_LinkProgram(program);
+            return;
+        }
+        dmhash_t key = *program_key;
+        cache->m_ProgramKeys.Erase(program);
+
+        CachedProgram* cached = cache->m_Programs.Get(key);
+        if (cached)
+        {
+            glad_glProgramBinary(program, cached->m_Format, cached->m_Data, cached->m_Size);
+            GLint status = GL_FALSE;
+            glad_glGetProgramiv(program, GL_LINK_STATUS, &status);
+            if (status == GL_TRUE)
+            {
+                // The shaders are never compiled, unless they're queried
+                return;
+            }
+
+            // Rejected by the driver (e.g. after a driver update with the same version string)
+            free(cached->m_Data);
+            cache->m_Programs.Erase(key);
+        }
+
+        for (GLsizei i = 0; i < shader_count; ++i)
+            CompilePendingShader(shaders[i]);
+
+        glad_glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        cache->m_LinkProgram(program);
+
+        GLint status = GL_FALSE;
+        glad_glGetProgramiv(program, GL_LINK_STATUS, &status);
+        GLint size = 0;
+        glad_glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+        if (status != GL_TRUE || size <= 0)
+            return;
+
+        if ((uint32_t) size > MAX_PROGRAM_BINARY_SIZE)
+            return;
+
+        CachedProgram binary;
+        binary.m_Data = (uint8_t*) malloc(size);
+        if (!binary.m_Data)
+            return;
+        GLsizei written = 0;
+        GLenum format = 0;
+        glad_glGetProgramBinary(program, size, &written, &format, binary.m_Data);
+        if (written <= 0)
+        {
+            free(binary.m_Data);
+            return;
+        }
+        binary.m_Format = format;
+        binary.m_Size   = (uint32_t) written;
+        PutGrow(cache->m_Programs, (uint64_t) key, binary);
+        WriteProgram(cache, key, binary);
+    }
+
+    static void APIENTRY HookDeleteProgram(GLuint program)
+    {
+        GLuint shaders[8];
+        GLsizei shader_count = 0;
+        if (program != 0)
+            glad_glGetAttachedShaders(program, sizeof(shaders) / sizeof(shaders[0]), &shader_count, shaders);
+
+        g_ProgramCache->m_ProgramKeys.Erase(program);
+        g_ProgramCache->m_DeleteProgram(program);
+
+        for (GLsizei i = 0; i < shader_count; ++i)
+            ErasePendingShader(shaders[i]);
+    }
+
+    static uint64_t GetDriverHash()
+    {
+        HashState64 state;
+        dmHashInit64(&state, false);
+        const GLenum names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+        for (uint32_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+        {
+            const char* value = (const char*) glGetString(names[i]);
+            if (value)
+                dmHashUpdateBuffer64(&state, value, strlen(value));
+        }
+        return dmHashFinal64(&state);
+    }
+
+    void InstallProgramCacheOpenGL(const char* path)
+    {
+        if (!path || g_ProgramCache)
+            return;
+
+        GLint format_count = 0;
+        if (glad_glProgramBinary && glad_glGetProgramBinary && glad_glProgramParameteri)
+        {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+        }
+        if (format_count <= 0)
+        {
+            dmLogInfo("The driver doesn't support program binaries, the Rive programs won't be cached");
+            return;
+        }
+
+        ProgramCache* cache = new ProgramCache();
+        dmStrlCpy(cache->m_Path, path, sizeof(cache->m_Path));
+        cache->m_DriverHash = GetDriverHash();
+        cache->m_FileValid  = 0;
+        LoadProgramCache(cache);
+
+        cache->m_ShaderSource       = glad_glShaderSource;
+        cache->m_CompileShader      = glad_glCompileShader;
+        cache->m_GetShaderiv        = glad_glGetShaderiv;
+        cache->m_GetShaderInfoLog   = glad_glGetShaderInfoLog;
+        cache->m_DeleteShader       = glad_glDeleteShader;
+        cache->m_AttachShader       = glad_glAttachShader;
+        cache->m_BindAttribLocation = glad_glBindAttribLocation;
+        cache->m_LinkProgram        = glad_glLinkProgram;
+        cache->m_DeleteProgram      = glad_glDeleteProgram;
+        g_ProgramCache = cache;
+
+        glad_glShaderSource       = HookShaderSource;
+        glad_glCompileShader      = HookCompileShader;
+        glad_glGetShaderiv        = HookGetShaderiv;
+        glad_glGetShaderInfoLog   = HookGetShaderInfoLog;
+        glad_glDeleteShader       = HookDeleteShader;
+        glad_glAttachShader       = HookAttachShader;
+        glad_glBindAttribLocation = HookBindAttribLocation;
+        glad_glLinkProgram        = HookLinkProgram;
+        glad_glDeleteProgram      = HookDeleteProgram;
+
+        dmLogInfo("Loaded %u cached Rive programs from '%s'", cache->m_Programs.Size(), cache->m_Path);
+    }
+}
+
+#endif // DM_RIVE_USE_OPENGL && RIVE_DESKTOP_GL
@@ -8,23 +8,40 @@
 
 namespace dmRive
 {
+	// An offscreen target that frames are flushed to, and its backing texture
+	class IDefoldRiveRenderTarget
+	{
+	public:
+		virtual ~IDefoldRiveRenderTarget() {}
+		virtual void OnSizeChanged(uint32_t width, uint32_t height, uint32_t sample_count) = 0;
+		virtual dmGraphics::HTexture GetBackingTexture() = 0;
+	};
+
+	// The GPU resources (shaders, gradient and tessellation textures) shared by all render contexts
 	class IDefoldRiveRenderer
 	{
 	public:
 		virtual ~IDefoldRiveRenderer() {}
 		virtual rive::Factory* Factory() = 0;
 		virtual rive::Renderer* MakeRenderer() = 0;
-		virtual void OnSizeChanged(uint32_t width, uint32_t height, uint32_t sample_count) = 0;
+		virtual IDefoldRiveRenderTarget* NewRenderTarget() = 0;
 		virtual void BeginFrame(const rive::gpu::RenderContext::FrameDescriptor& frameDescriptor) = 0;
-		virtual void Flush() = 0;
+		virtual void Flush(IDefoldRiveRenderTarget* target) = 0;
 		virtual void SetRenderTargetTexture(dmGraphics::HTexture texture) = 0;
 		virtual void SetGraphicsContext(dmGraphics::HContext graphics_context) = 0;
+		// When false, the pipeline state changed by the flush is left as is
+		virtual void SetRestoreState(bool restore) = 0;
 
-		virtual dmGraphics::HTexture GetBackingTexture() = 0;
 		virtual rive::rcp<rive::gpu::Texture> MakeImageTexture(uint32_t width, uint32_t height, uint32_t mipLevelCount, const uint8_t imageDataRGBA[]) = 0;
 	};
 
+	// Set with SetProgramCachePath(), or 0 if the programs aren't cached
+	const char* GetProgramCachePath();
+	// Loads the program binaries from the path, and caches the programs linked from then on. Desktop OpenGL only
+	void InstallProgramCacheOpenGL(const char* path);
+
 	IDefoldRiveRenderer* MakeDefoldRiveRendererMetal();
 	IDefoldRiveRenderer* MakeDefoldRiveRendererOpenGL();
 	IDefoldRiveRenderer* MakeDefoldRiveRendererWebGPU();
+	IDefoldRiveRenderer* MakeDefoldRiveRendererTess();
 }
@@ -14,6 +14,50 @@
 
 namespace dmRive
 {
+    // A Defold texture, that the rive render target draws into
+    class DefoldRiveRenderTargetMetal : public IDefoldRiveRenderTarget
+    {
+    public:
+        DefoldRiveRenderTargetMetal(dmGraphics::HContext graphics_context, rive::gpu::RenderContextMetalImpl* render_context_impl)
+        : m_GraphicsContext(graphics_context)
+        , m_RenderContextImpl(render_context_impl)
+        {
+            m_BackingTexture = dmGraphics::NewTexture(m_GraphicsContext, {});
+        }
+
+        ~DefoldRiveRenderTargetMetal() override
+        {
+            dmGraphics::DeleteTexture(m_BackingTexture);
+        }
+
+        void OnSizeChanged(uint32_t width, uint32_t height, uint32_t sample_count) override
+        {
+            m_RenderTarget = m_RenderContextImpl->makeRenderTarget(MTLPixelFormatBGRA8Unorm, width, height);
+
+            dmGraphics::TextureParams tp = {};
+            tp.m_Width                   = width;
+            tp.m_Height                  = height;
+            tp.m_Format                  = dmGraphics::TEXTURE_FORMAT_BGRA8U;
+
+            dmGraphics::SetTexture(m_BackingTexture, tp);
+
+            void* opaque_backing_texture = dmGraphics::VulkanTextureToMetal(m_GraphicsContext, m_BackingTexture);
+            assert(opaque_backing_texture);
+            id<MTLTexture> mtl_texture = (__bridge id<MTLTexture>) opaque_backing_texture;
+            m_RenderTarget->setTargetTexture(mtl_texture);
+        }
+
+        dmGraphics::HTexture GetBackingTexture() override
+        {
+            return m_BackingTexture;
+        }
+
+        dmGraphics::HContext                      m_GraphicsContext;
+        rive::gpu::RenderContextMetalImpl*        m_RenderContextImpl;
+        rive::rcp<rive::gpu::RenderTargetMetal>   m_RenderTarget;
+        dmGraphics::HTexture                      m_BackingTexture;
+    };
+
     class DefoldRiveRendererMetal : public IDefoldRiveRenderer
     {
     public:
@@ -41,33 +85,21 @@ namespace dmRive
             m_RenderContext->beginFrame(frameDescriptor);
         }
 
-        void Flush() override
+        void Flush(IDefoldRiveRenderTarget* target) override
         {
             id<MTLCommandBuffer> flushCommandBuffer = [m_Queue commandBuffer];
             m_RenderContext->flush({
-                .renderTarget = m_RenderTarget.get(),
+                .renderTarget = ((DefoldRiveRenderTargetMetal*) target)->m_RenderTarget.get(),
                 .externalCommandBuffer = (__bridge void*) flushCommandBuffer
             });
 
             [flushCommandBuffer commit];
         }
 
-        void OnSizeChanged(uint32_t width, uint32_t height, uint32_t sample_count) override
+        IDefoldRiveRenderTarget* NewRenderTarget() override
         {
             auto renderContextImpl = m_RenderContext->static_impl_cast<rive::gpu::RenderContextMetalImpl>();
-            m_RenderTarget         = renderContextImpl->makeRenderTarget(MTLPixelFormatBGRA8Unorm, width, height);
-
-            dmGraphics::TextureParams tp = {};
-            tp.m_Width                   = width;
-            tp.m_Height                  = height;
-            tp.m_Format                  = dmGraphics::TEXTURE_FORMAT_BGRA8U;
-
-            dmGraphics::SetTexture(m_BackingTexture, tp);
-
-            void* opaque_backing_texture = dmGraphics::VulkanTextureToMetal(m_GraphicsContext, m_BackingTexture);
-            assert(opaque_backing_texture);
-            id<MTLTexture> mtl_texture = (__bridge id<MTLTexture>) opaque_backing_texture;
-            m_RenderTarget->setTargetTexture(mtl_texture);
+            return new DefoldRiveRenderTargetMetal(m_GraphicsContext, renderContextImpl);
         }
 
         void SetGraphicsContext(dmGraphics::HContext graphics_context) override
@@ -78,17 +110,16 @@ namespace dmRive
             void* cmd_queue = dmGraphics::VulkanGraphicsCommandQueueToMetal(graphics_context);
             assert(cmd_queue);
             m_Queue = (__bridge id<MTLCommandQueue>) cmd_queue;
-            m_BackingTexture = dmGraphics::NewTexture(m_GraphicsContext, {});
         }
 
-        void SetRenderTargetTexture(dmGraphics::HTexture texture) override
+        void SetRestoreState(bool restore) override
         {
-            m_TargetTexture = texture;
+            // The pipeline state isn't shared with Defold
         }
 
-        dmGraphics::HTexture GetBackingTexture() override
+        void SetRenderTargetTexture(dmGraphics::HTexture texture) override
         {
-            return m_BackingTexture;
+            m_TargetTexture = texture;
         }
 
         rive::rcp<rive::gpu::Texture> MakeImageTexture(uint32_t width,
@@ -109,9 +140,7 @@ namespace dmRive
         id<MTLDevice>                             m_GPU   = MTLCreateSystemDefaultDevice();
         id<MTLCommandQueue>                       m_Queue;
         std::unique_ptr<rive::gpu::RenderContext> m_RenderContext;
-        rive::rcp<rive::gpu::RenderTargetMetal>   m_RenderTarget;
         dmGraphics::HContext                      m_GraphicsContext;
-        dmGraphics::HTexture                      m_BackingTexture;
         dmGraphics::HTexture                      m_TargetTexture;
     };
 
@@ -61,83 +61,20 @@ namespace dmGraphics
 
 namespace dmRive
 {
-    class DefoldRiveRendererOpenGL : public IDefoldRiveRenderer
+    // A Defold render target, so that the color buffer can be used as a texture when compositing
+    class DefoldRiveRenderTargetOpenGL : public IDefoldRiveRenderTarget
     {
     public:
-        DefoldRiveRendererOpenGL()
-        {
-        #ifdef RIVE_DESKTOP_GL
-            // Load the OpenGL API using glad.
-            if (!gladLoadCustomLoader((GLADloadproc)glfwGetProcAddress))
-            {
-                fprintf(stderr, "Failed to initialize glad.\n");
-                abort();
-            }
-        #endif
-
-            dmLogInfo("==== GL GPU: %s ====\n", glGetString(GL_RENDERER));
-
-            m_DefoldRenderTarget = 0;
-
-            m_RenderContext = rive::gpu::RenderContextGLImpl::MakeContext({
-                .disableFragmentShaderInterlock = false // options.disableRasterOrdering,
-            });
-        }
-
-        rive::Factory* Factory() override
-        {
-            return m_RenderContext.get();
-        }
-
-        rive::Renderer* MakeRenderer() override
+        DefoldRiveRenderTargetOpenGL(dmGraphics::HContext graphics_context)
+        : m_GraphicsContext(graphics_context)
+        , m_DefoldRenderTarget(0)
         {
-            return new rive::RiveRenderer(m_RenderContext.get());
         }
 
-        void BeginFrame(const rive::gpu::RenderContext::FrameDescriptor& frameDescriptor) override
+        ~DefoldRiveRenderTargetOpenGL() override
         {
-            m_DefoldPipelineState = dmGraphics::GetPipelineState(m_GraphicsContext);
-            m_RenderContext->static_impl_cast<rive::gpu::RenderContextGLImpl>()->invalidateGLState();
-            m_RenderContext->beginFrame(frameDescriptor);
-            OpenGLCheckError("BeginFrame After");
-        }
-
-        void Flush() override
-        {
-            m_RenderContext->flush({.renderTarget = m_RenderTarget.get()});
-            m_RenderContext->static_impl_cast<rive::gpu::RenderContextGLImpl>()->unbindGLInternalResources();
-            OpenGLCheckError("Flush After");
-
-            // TODO: We should bind the currently bound target
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-            // Rive messes up the state after flush it seems.
-            SetDefoldGraphicsState(dmGraphics::STATE_CULL_FACE, m_DefoldPipelineState.m_CullFaceEnabled);
-            SetDefoldGraphicsState(dmGraphics::STATE_BLEND, m_DefoldPipelineState.m_BlendEnabled);
-
-            dmGraphics::SetCullFace(m_GraphicsContext, (dmGraphics::FaceType) m_DefoldPipelineState.m_CullFaceType);
-            dmGraphics::SetBlendFunc(m_GraphicsContext, (dmGraphics::BlendFactor) m_DefoldPipelineState.m_BlendSrcFactor, (dmGraphics::BlendFactor) m_DefoldPipelineState.m_BlendDstFactor);
-
-            dmGraphics::SetStencilMask(m_GraphicsContext, m_DefoldPipelineState.m_StencilWriteMask);
-
-            dmGraphics::SetStencilFuncSeparate(m_GraphicsContext, dmGraphics::FACE_TYPE_FRONT, (dmGraphics::CompareFunc) m_DefoldPipelineState.m_StencilFrontTestFunc, m_DefoldPipelineState.m_StencilReference, m_DefoldPipelineState.m_StencilCompareMask);
-            dmGraphics::SetStencilFuncSeparate(m_GraphicsContext, dmGraphics::FACE_TYPE_BACK, (dmGraphics::CompareFunc) m_DefoldPipelineState.m_StencilBackTestFunc, m_DefoldPipelineState.m_StencilReference, m_DefoldPipelineState.m_StencilCompareMask);
-
-            dmGraphics::SetStencilOpSeparate(m_GraphicsContext, dmGraphics::FACE_TYPE_FRONT,
-                (dmGraphics::StencilOp) m_DefoldPipelineState.m_StencilFrontOpFail,
-                (dmGraphics::StencilOp) m_DefoldPipelineState.m_StencilFrontOpDepthFail,
-                (dmGraphics::StencilOp) m_DefoldPipelineState.m_StencilFrontOpPass);
-
-            dmGraphics::SetStencilOpSeparate(m_GraphicsContext, dmGraphics::FACE_TYPE_BACK,
-                (dmGraphics::StencilOp) m_DefoldPipelineState.m_StencilBackOpFail,
-                (dmGraphics::StencilOp) m_DefoldPipelineState.m_StencilBackOpDepthFail,
-                (dmGraphics::StencilOp) m_DefoldPipelineState.m_StencilBackOpPass);
-
-            dmGraphics::SetColorMask(m_GraphicsContext,
-                m_DefoldPipelineState.m_WriteColorMask & (1<<3),
-                m_DefoldPipelineState.m_WriteColorMask & (1<<2),
-                m_DefoldPipelineState.m_WriteColorMask & (1<<1),
-                m_DefoldPipelineState.m_WriteColorMask & (1<<0));
+            if (m_DefoldRenderTarget)
+                dmGraphics::DeleteRenderTarget(m_DefoldRenderTarget);
         }
 
         void OnSizeChanged(uint32_t width, uint32_t height, uint32_t sample_count) override
@@ -205,6 +142,191 @@ namespace dmRive
             glViewport(0, 0, width, height);
         }
 
+        dmGraphics::HTexture GetBackingTexture() override
+        {
+            return dmGraphics::GetRenderTargetTexture(m_DefoldRenderTarget, dmGraphics::BUFFER_TYPE_COLOR0_BIT);
+        }
+
+        dmGraphics::HContext                      m_GraphicsContext;
+        dmGraphics::HRenderTarget                 m_DefoldRenderTarget;
+        rive::rcp<rive::gpu::RenderTargetGL>      m_RenderTarget;
+    };
+
+    // Indexed by dmGraphics::BlendFactor
+    static const GLenum g_GLBlendFactors[] = {
+        GL_ZERO, GL_ONE, GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR, GL_DST_COLOR, GL_ONE_MINUS_DST_COLOR,
+        GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_SRC_ALPHA_SATURATE,
+        GL_CONSTANT_COLOR, GL_ONE_MINUS_CONSTANT_COLOR, GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA,
+    };
+
+    // Indexed by dmGraphics::CompareFunc
+    static const GLenum g_GLCompareFuncs[] = {
+        GL_NEVER, GL_LESS, GL_LEQUAL, GL_GREATER, GL_GEQUAL, GL_EQUAL, GL_NOTEQUAL, GL_ALWAYS,
+    };
+
+    // Indexed by dmGraphics::StencilOp
+    static const GLenum g_GLStencilOps[] = {
+        GL_KEEP, GL_ZERO, GL_REPLACE, GL_INCR, GL_INCR_WRAP, GL_DECR, GL_DECR_WRAP, GL_INVERT,
+    };
+
+    // Indexed by dmGraphics::FaceType
+    static const GLenum g_GLFaceTypes[] = {
+        GL_FRONT, GL_BACK, GL_FRONT_AND_BACK,
+    };
+
+    // The bits of dmGraphics::PipelineState::m_WriteColorMask, as set by dmGraphics::SetColorMask()
+    // (DM_GRAPHICS_STATE_WRITE_R etc. in the engine). Red is the lowest bit
+    static const uint32_t WRITE_COLOR_MASK_R = 0x1;
+    static const uint32_t WRITE_COLOR_MASK_G = 0x2;
+    static const uint32_t WRITE_COLOR_MASK_B = 0x4;
+    static const uint32_t WRITE_COLOR_MASK_A = 0x8;
+
+    // Groups of GL states that Rive may change during a flush
+    enum RiveGLStates
+    {
+        RIVE_GL_STATE_BLEND       = 0x01, // GL_BLEND, the blend equation and the blend function
+        RIVE_GL_STATE_WRITE_MASKS = 0x02, // The color, depth and stencil write masks
+        RIVE_GL_STATE_CULL_FACE   = 0x04, // GL_CULL_FACE and the culled face
+        RIVE_GL_STATE_DEPTH       = 0x08, // GL_DEPTH_TEST and the depth function
+        RIVE_GL_STATE_STENCIL     = 0x10, // GL_STENCIL_TEST, the stencil functions and operations
+        RIVE_GL_STATE_FRONT_FACE  = 0x20,
+    };
+
+    // The blending, the write masks and the culling are set through Rive's GLState for every draw.
+    // Depth and stencil testing (and the winding they depend on) are only used when drawing in the depthStencil mode
+    static uint32_t GetRiveGLStates(rive::gpu::InterlockMode interlock_mode)
+    {
+        uint32_t states = RIVE_GL_STATE_BLEND | RIVE_GL_STATE_WRITE_MASKS | RIVE_GL_STATE_CULL_FACE;
+        if (interlock_mode == rive::gpu::InterlockMode::depthStencil)
+        {
+            states |= RIVE_GL_STATE_DEPTH | RIVE_GL_STATE_STENCIL | RIVE_GL_STATE_FRONT_FACE;
+        }
+        return states;
+    }
+
+    static void SetCapability(GLenum capability, bool enabled)
+    {
+        if (enabled)
+            glEnable(capability);
+        else
+            glDisable(capability);
+    }
+
+    // Sets the GL states that Rive changed during the flush back to the state last set by Defold.
+    // The values Rive leaves can't be read without querying the driver, so each group it may have changed is set,
+    // and the groups it doesn't use in the frame's interlock mode are left as they are.
+    // The state is taken from the copy Defold keeps on the CPU, so nothing is read back from the driver
+    static void RestorePipelineState(const dmGraphics::PipelineState& ps, uint32_t states)
+    {
+        if (states & RIVE_GL_STATE_BLEND)
+        {
+            SetCapability(GL_BLEND, ps.m_BlendEnabled);
+            // Defold always blends with GL_FUNC_ADD
+            glBlendEquation(GL_FUNC_ADD);
+            glBlendFunc(g_GLBlendFactors[ps.m_BlendSrcFactor], g_GLBlendFactors[ps.m_BlendDstFactor]);
+        }
+
+        if (states & RIVE_GL_STATE_WRITE_MASKS)
+        {
+            glColorMask((ps.m_WriteColorMask & WRITE_COLOR_MASK_R) != 0,
+                        (ps.m_WriteColorMask & WRITE_COLOR_MASK_G) != 0,
+                        (ps.m_WriteColorMask & WRITE_COLOR_MASK_B) != 0,
+                        (ps.m_WriteColorMask & WRITE_COLOR_MASK_A) != 0);
+            glDepthMask(ps.m_WriteDepth);
+            glStencilMask(ps.m_StencilWriteMask);
+        }
+
+        if (states & RIVE_GL_STATE_CULL_FACE)
+        {
+            SetCapability(GL_CULL_FACE, ps.m_CullFaceEnabled);
+            glCullFace(g_GLFaceTypes[ps.m_CullFaceType]);
+        }
+
+        if (states & RIVE_GL_STATE_DEPTH)
+        {
+            SetCapability(GL_DEPTH_TEST, ps.m_DepthTestEnabled);
+            glDepthFunc(g_GLCompareFuncs[ps.m_DepthTestFunc]);
+        }
+
+        if (states & RIVE_GL_STATE_STENCIL)
+        {
+            SetCapability(GL_STENCIL_TEST, ps.m_StencilEnabled);
+            glStencilFuncSeparate(GL_FRONT, g_GLCompareFuncs[ps.m_StencilFrontTestFunc], ps.m_StencilReference, ps.m_StencilCompareMask);
+            glStencilFuncSeparate(GL_BACK, g_GLCompareFuncs[ps.m_StencilBackTestFunc], ps.m_StencilReference, ps.m_StencilCompareMask);
+            glStencilOpSeparate(GL_FRONT, g_GLStencilOps[ps.m_StencilFrontOpFail], g_GLStencilOps[ps.m_StencilFrontOpDepthFail], g_GLStencilOps[ps.m_StencilFrontOpPass]);
+            glStencilOpSeparate(GL_BACK, g_GLStencilOps[ps.m_StencilBackOpFail], g_GLStencilOps[ps.m_StencilBackOpDepthFail], g_GLStencilOps[ps.m_StencilBackOpPass]);
+        }
+
+        if (states & RIVE_GL_STATE_FRONT_FACE)
+        {
+            glFrontFace(ps.m_FaceWinding == 0 ? GL_CCW : GL_CW);
+        }
+    }
+
+    class DefoldRiveRendererOpenGL : public IDefoldRiveRenderer
+    {
+    public:
+        DefoldRiveRendererOpenGL()
+        {
+        #ifdef RIVE_DESKTOP_GL
+            // Load the OpenGL API using glad.
+            if (!gladLoadCustomLoader((GLADloadproc)glfwGetProcAddress))
+            {
+                fprintf(stderr, "Failed to initialize glad.\n");
+                abort();
+            }
+            InstallProgramCacheOpenGL(GetProgramCachePath());
+        #endif
+
+            dmLogInfo("==== GL GPU: %s ====\n", glGetString(GL_RENDERER));
+
+            m_RestoreState = true;
+
+            m_RenderContext = rive::gpu::RenderContextGLImpl::MakeContext({
+                .disableFragmentShaderInterlock = false // options.disableRasterOrdering,
+            });
+        }
+
+        rive::Factory* Factory() override
+        {
+            return m_RenderContext.get();
+        }
+
+        rive::Renderer* MakeRenderer() override
+        {
+            return new rive::RiveRenderer(m_RenderContext.get());
+        }
+
+        void BeginFrame(const rive::gpu::RenderContext::FrameDescriptor& frameDescriptor) override
+        {
+            m_RenderContext->static_impl_cast<rive::gpu::RenderContextGLImpl>()->invalidateGLState();
+            m_RenderContext->beginFrame(frameDescriptor);
+            OpenGLCheckError("BeginFrame After");
+        }
+
+        void Flush(IDefoldRiveRenderTarget* target) override
+        {
+            uint32_t rive_states = GetRiveGLStates(m_RenderContext->frameInterlockMode());
+            m_RenderContext->flush({.renderTarget = ((DefoldRiveRenderTargetOpenGL*) target)->m_RenderTarget.get()});
+            m_RenderContext->static_impl_cast<rive::gpu::RenderContextGLImpl>()->unbindGLInternalResources();
+            OpenGLCheckError("Flush After");
+
+            // TODO: We should bind the currently bound target
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+            // Rive messes up the state after flush, so the states it changes are set back to what Defold expects.
+            // Defold doesn't draw during the frame, so its state is the same as before the frame
+            if (m_RestoreState)
+            {
+                RestorePipelineState(dmGraphics::GetPipelineState(m_GraphicsContext), rive_states);
+            }
+        }
+
+        IDefoldRiveRenderTarget* NewRenderTarget() override
+        {
+            return new DefoldRiveRenderTargetOpenGL(m_GraphicsContext);
+        }
+
         void SetGraphicsContext(dmGraphics::HContext graphics_context) override
         {
             m_GraphicsContext = graphics_context;
@@ -215,9 +337,9 @@ namespace dmRive
 
         }
 
-        dmGraphics::HTexture GetBackingTexture() override
+        void SetRestoreState(bool restore) override
         {
-            return dmGraphics::GetRenderTargetTexture(m_DefoldRenderTarget, dmGraphics::BUFFER_TYPE_COLOR0_BIT);
+            m_RestoreState = restore;
         }
 
         rive::rcp<rive::gpu::Texture> MakeImageTexture(uint32_t width,
@@ -235,20 +357,9 @@ namespace dmRive
         }
 
     private:
-
-        void SetDefoldGraphicsState(dmGraphics::State state, bool flag)
-        {
-            if (flag)
-                dmGraphics::EnableState(m_GraphicsContext, state);
-            else
-                dmGraphics::DisableState(m_GraphicsContext, state);
-        }
-
         std::unique_ptr<rive::gpu::RenderContext> m_RenderContext;
         dmGraphics::HContext                      m_GraphicsContext;
-        rive::rcp<rive::gpu::RenderTargetGL>      m_RenderTarget;
-        dmGraphics::PipelineState                 m_DefoldPipelineState;
-        dmGraphics::HRenderTarget                 m_DefoldRenderTarget;
+        bool                                      m_RestoreState;
     };
 
     IDefoldRiveRenderer* MakeDefoldRiveRendererOpenGL()
@@ -0,0 +1,76 @@
+#include "renderer_context.h"
+
+#include <common/factory.h>
+#include <common/tess_renderer.h>
+
+namespace dmRive
+{
+    // The tessellation renderer only records draw descriptors, which are turned into render objects by the component.
+    // Nothing is drawn offscreen, so the targets are empty
+    class DefoldRiveRenderTargetTess : public IDefoldRiveRenderTarget
+    {
+    public:
+        void OnSizeChanged(uint32_t width, uint32_t height, uint32_t sample_count) override
+        {
+        }
+
+        dmGraphics::HTexture GetBackingTexture() override
+        {
+            return 0;
+        }
+    };
+
+    class DefoldRiveRendererTess : public IDefoldRiveRenderer
+    {
+    public:
+        rive::Factory* Factory() override
+        {
+            return &m_Factory;
+        }
+
+        rive::Renderer* MakeRenderer() override
+        {
+            return new DefoldTessRenderer();
+        }
+
+        IDefoldRiveRenderTarget* NewRenderTarget() override
+        {
+            return new DefoldRiveRenderTargetTess();
+        }
+
+        void BeginFrame(const rive::gpu::RenderContext::FrameDescriptor& frameDescriptor) override
+        {
+        }
+
+        void Flush(IDefoldRiveRenderTarget* target) override
+        {
+        }
+
+        void SetRenderTargetTexture(dmGraphics::HTexture texture) override
+        {
+        }
+
+        void SetGraphicsContext(dmGraphics::HContext graphics_context) override
+        {
+        }
+
+        void SetRestoreState(bool restore) override
+        {
+            // The render objects use the pipeline state of their material
+        }
+
+        rive::rcp<rive::gpu::Texture> MakeImageTexture(uint32_t width, uint32_t height, uint32_t mipLevelCount, const uint8_t imageDataRGBA[]) override
+        {
+            // The images are drawn from the atlas of the rive scene, see AtlasNameResolver
+            return nullptr;
+        }
+
+    private:
+        DefoldFactory m_Factory;
+    };
+
+    IDefoldRiveRenderer* MakeDefoldRiveRendererTess()
+    {
+        return new DefoldRiveRendererTess();
+    }
+}
@@ -1,3 +1,4 @@
+#include <dmsdk/dlib/dstrings.h>
 #include <dmsdk/dlib/log.h>
 #include <dmsdk/dlib/image.h>
 #include <dmsdk/graphics/graphics_vulkan.h>
@@ -27,55 +28,96 @@ namespace dmResource
 
 namespace dmRive
 {
+    struct RenderContext;
+
+    // The GPU resources, shared by all render contexts
     struct DefoldRiveRenderer
+    {
+        IDefoldRiveRenderer* m_RenderContext;
+        dmResource::HFactory m_Factory;
+        rive::Renderer*      m_RiveRenderer;
+        dmGraphics::HContext m_GraphicsContext;
+
+        dmGraphics::HVertexProgram   m_BlitVs;
+        dmGraphics::HFragmentProgram m_BlitFs;
+        dmRender::HMaterial          m_BlitMaterial;
+
+        RenderContext*       m_ActiveContext; // The context with an open frame. Only one frame can be recorded at a time
+        uint32_t             m_ContextCount;
+    };
+
+    // The frame state of a camera or render target
+    struct RenderContext
+    {
+        DefoldRiveRenderer*                 m_Renderer;
+        dmArray<IDefoldRiveRenderTarget*>   m_Targets; // Created on demand, e.g. one per render group
+        uint32_t                            m_TargetIndex; // The target of the current (or last) frame
+        uint32_t                            m_LastWidth;
+        uint32_t                            m_LastHeight;
+        uint8_t                             m_FrameBegin : 1;
+    };
+
+    static IDefoldRiveRenderer* MakeDefoldRiveRendererPlatform()
     {
     #if defined(DM_PLATFORM_MACOS) || defined(DM_PLATFORM_IOS)
-        IDefoldRiveRenderer* m_RenderContext = MakeDefoldRiveRendererMetal();
+        return MakeDefoldRiveRendererMetal();
     #elif defined(DM_PLATFORM_WINDOWS)
-        IDefoldRiveRenderer* m_RenderContext = MakeDefoldRiveRendererOpenGL();
+        return MakeDefoldRiveRendererOpenGL();
     #elif defined(DM_PLATFORM_LINUX)
-        IDefoldRiveRenderer* m_RenderContext = MakeDefoldRiveRendererOpenGL();
+        return MakeDefoldRiveRendererOpenGL();
     #elif defined(DM_PLATFORM_ANDROID)
-        IDefoldRiveRenderer* m_RenderContext = MakeDefoldRiveRendererOpenGL();
+        return MakeDefoldRiveRendererOpenGL();
     #elif defined(DM_PLATFORM_HTML5)
         #ifdef RIVE_WEBGPU
-            IDefoldRiveRenderer* m_RenderContext = MakeDefoldRiveRendererWebGPU();
+            return MakeDefoldRiveRendererWebGPU();
         #else
-            IDefoldRiveRenderer* m_RenderContext = MakeDefoldRiveRendererOpenGL();
+            return MakeDefoldRiveRendererOpenGL();
         #endif
     #else
         #error "Platform not supported"
         assert(0 && "Platform not supported");
     #endif
-
-        dmResource::HFactory m_Factory;
-        rive::Renderer*      m_RiveRenderer;
-        dmGraphics::HContext m_GraphicsContext;
-
-        dmGraphics::HVertexProgram   m_BlitVs;
-        dmGraphics::HFragmentProgram m_BlitFs;
-        dmRender::HMaterial          m_BlitMaterial;
-
-        uint32_t             m_LastWidth;
-        uint32_t             m_LastHeight;
-        uint8_t              m_FrameBegin : 1;
-    };
+    }
 
     static DefoldRiveRenderer* g_RiveRenderer = 0;
+    static RendererType        g_RendererType = RENDERER_TYPE_DEFAULT;
+    static bool                g_RestorePipelineState = true;
+    static char                g_ProgramCachePath[1024] = {0};
 
     HRenderContext NewRenderContext()
     {
         if (g_RiveRenderer == 0)
         {
             g_RiveRenderer = new DefoldRiveRenderer();
-            g_RiveRenderer->m_RiveRenderer    = 0;
+            if (dmGraphics::GetInstalledAdapterFamily() == dmGraphics::ADAPTER_FAMILY_NULL)
+            {
+                g_RendererType = RENDERER_TYPE_TESSELLATION;
+            }
+
+            if (g_RendererType == RENDERER_TYPE_TESSELLATION)
+            {
+                // Doesn't draw anything itself, so it doesn't need the graphics context or the blit shaders (see RenderBegin())
+                g_RiveRenderer->m_RenderContext = MakeDefoldRiveRendererTess();
+                g_RiveRenderer->m_RiveRenderer  = g_RiveRenderer->m_RenderContext->MakeRenderer();
+            }
+            else
+            {
+                g_RiveRenderer->m_RenderContext = MakeDefoldRiveRendererPlatform();
+                g_RiveRenderer->m_RiveRenderer  = 0;
+            }
             g_RiveRenderer->m_GraphicsContext = 0;
-            g_RiveRenderer->m_LastWidth       = 0;
-            g_RiveRenderer->m_LastHeight      = 0;
-            g_RiveRenderer->m_FrameBegin      = 0;
+            g_RiveRenderer->m_ActiveContext   = 0;
+            g_RiveRenderer->m_ContextCount    = 0;
         }
-
-        return (HRenderContext) g_RiveRenderer;
+        g_RiveRenderer->m_ContextCount++;
+
+        RenderContext* context  = new RenderContext();
+        context->m_Renderer     = g_RiveRenderer;
+        context->m_TargetIndex  = 0;
+        context->m_LastWidth    = 0;
+        context->m_LastHeight   = 0;
+        context->m_FrameBegin   = 0;
+        return (HRenderContext) context;
     }
 
     static void AddShaderResources(dmResource::HFactory factory)
@@ -129,42 +171,61 @@ namespace dmRive
         *resources = 0;
     }
 
-    void DeleteRenderContext(HRenderContext context)
+    void DeleteRenderContext(HRenderContext _context)
     {
-        if (g_RiveRenderer)
+        RenderContext* context = (RenderContext*) _context;
+        DefoldRiveRenderer* renderer = context->m_Renderer;
+        if (renderer->m_ActiveContext == context)
+        {
+            renderer->m_ActiveContext = 0;
+        }
+
+        for (uint32_t i = 0; i < context->m_Targets.Size(); ++i)
+        {
+            delete context->m_Targets[i];
+        }
+        delete context;
+
+        // The GPU resources are kept until the last context is deleted
+        if (--renderer->m_ContextCount == 0)
         {
-            ReleaseShadersInternal(g_RiveRenderer->m_Factory);
-            delete g_RiveRenderer;
+            if (renderer->m_RiveRenderer && g_RendererType != RENDERER_TYPE_TESSELLATION)
+                ReleaseShadersInternal(renderer->m_Factory);
+            delete renderer;
             g_RiveRenderer = 0;
         }
     }
 
     rive::Factory* GetRiveFactory(HRenderContext context)
     {
-        DefoldRiveRenderer* renderer = (DefoldRiveRenderer*) context;
+        DefoldRiveRenderer* renderer = ((RenderContext*) context)->m_Renderer;
         return renderer->m_RenderContext->Factory();
     }
 
     rive::Renderer* GetRiveRenderer(HRenderContext context)
     {
-        DefoldRiveRenderer* renderer = (DefoldRiveRenderer*) context;
+        DefoldRiveRenderer* renderer = ((RenderContext*) context)->m_Renderer;
         return renderer->m_RiveRenderer;
     }
 
-    dmGraphics::HTexture GetBackingTexture(HRenderContext context)
+    dmGraphics::HTexture GetBackingTexture(HRenderContext _context)
     {
-        DefoldRiveRenderer* renderer = (DefoldRiveRenderer*) context;
-        return renderer->m_RenderContext->GetBackingTexture();
+        RenderContext* context = (RenderContext*) _context;
+        if (context->m_TargetIndex >= context->m_Targets.Size())
+            return 0;
+        return context->m_Targets[context->m_TargetIndex]->GetBackingTexture();
     }
 
-    void RenderBegin(HRenderContext context, dmResource::HFactory factory)
+    void RenderBegin(HRenderContext _context, dmResource::HFactory factory, uint32_t target_index)
     {
-        DefoldRiveRenderer* renderer = (DefoldRiveRenderer*) context;
+        RenderContext* context       = (RenderContext*) _context;
+        DefoldRiveRenderer* renderer = context->m_Renderer;
 
         if (!renderer->m_RiveRenderer)
         {
             renderer->m_GraphicsContext = dmGraphics::GetInstalledContext();
             renderer->m_RenderContext->SetGraphicsContext(renderer->m_GraphicsContext);
+            renderer->m_RenderContext->SetRestoreState(g_RestorePipelineState);
             renderer->m_RiveRenderer = renderer->m_RenderContext->MakeRenderer();
             renderer->m_Factory = factory;
 
@@ -172,19 +233,38 @@ namespace dmRive
             dmResource::IncRef(factory, (void*) renderer->m_BlitFs);
         }
 
-        if (!renderer->m_FrameBegin)
+        if (!context->m_FrameBegin)
         {
+            // The frames of different contexts can't be interleaved, so the other frame is flushed first
+            if (renderer->m_ActiveContext)
+            {
+                RenderEnd((HRenderContext) renderer->m_ActiveContext);
+            }
+
             uint32_t width  = dmGraphics::GetWindowWidth(renderer->m_GraphicsContext);
             uint32_t height = dmGraphics::GetWindowHeight(renderer->m_GraphicsContext);
 
-            if (width != renderer->m_LastWidth || height != renderer->m_LastHeight)
+            if (width != context->m_LastWidth || height != context->m_LastHeight)
             {
                 dmLogInfo("Change size to %d, %d", width, height);
-                renderer->m_RenderContext->OnSizeChanged(width, height, 0);
-                renderer->m_LastWidth  = width;
-                renderer->m_LastHeight = height;
+                for (uint32_t i = 0; i < context->m_Targets.Size(); ++i)
+                {
+                    context->m_Targets[i]->OnSizeChanged(width, height, 0);
+                }
+                context->m_LastWidth  = width;
+                context->m_LastHeight = height;
             }
 
+            while (context->m_Targets.Size() <= target_index)
+            {
+                IDefoldRiveRenderTarget* target = renderer->m_RenderContext->NewRenderTarget();
+                target->OnSizeChanged(width, height, 0);
+                if (context->m_Targets.Full())
+                    context->m_Targets.OffsetCapacity(4);
+                context->m_Targets.Push(target);
+            }
+            context->m_TargetIndex = target_index;
+
         #if defined(DM_PLATFORM_MACOS) || defined(DM_PLATFORM_IOS)
             dmGraphics::HTexture swap_chain_texture = dmGraphics::VulkanGetActiveSwapChainTexture(renderer->m_GraphicsContext);
             renderer->m_RenderContext->SetRenderTargetTexture(swap_chain_texture);
@@ -201,28 +281,60 @@ namespace dmRive
                 // .strokesDisabled        = s_disableStroke,
             });
 
-            renderer->m_FrameBegin = 1;
+            context->m_FrameBegin = 1;
+            renderer->m_ActiveContext = context;
         }
     }
 
-    void GetDimensions(HRenderContext context, uint32_t* width, uint32_t* height)
+    void GetDimensions(HRenderContext _context, uint32_t* width, uint32_t* height)
     {
-        DefoldRiveRenderer* renderer = (DefoldRiveRenderer*) context;
-        *width = renderer->m_LastWidth;
-        *height = renderer->m_LastHeight;
+        RenderContext* context = (RenderContext*) _context;
+        *width = context->m_LastWidth;
+        *height = context->m_LastHeight;
     }
 
-    void RenderEnd(HRenderContext context)
+    void RenderEnd(HRenderContext _context)
     {
-        DefoldRiveRenderer* renderer = (DefoldRiveRenderer*) context;
+        RenderContext* context       = (RenderContext*) _context;
+        DefoldRiveRenderer* renderer = context->m_Renderer;
 
-        if (renderer->m_FrameBegin)
+        if (context->m_FrameBegin)
         {
-            renderer->m_RenderContext->Flush();
-            renderer->m_FrameBegin = 0;
+            renderer->m_RenderContext->Flush(context->m_Targets[context->m_TargetIndex]);
+            context->m_FrameBegin = 0;
+            renderer->m_ActiveContext = 0;
         }
     }
 
+    void SetRestorePipelineState(bool restore)
+    {
+        g_RestorePipelineState = restore;
+        if (g_RiveRenderer)
+        {
+            g_RiveRenderer->m_RenderContext->SetRestoreState(restore);
+        }
+    }
+
+    void SetRendererType(RendererType type)
+    {
+        g_RendererType = type;
+    }
+
+    RendererType GetRendererType()
+    {
+        return g_RendererType;
+    }
+
+    void SetProgramCachePath(const char* path)
+    {
+        dmStrlCpy(g_ProgramCachePath, path ? path : "", sizeof(g_ProgramCachePath));
+    }
+
+    const char* GetProgramCachePath()
+    {
+        return g_ProgramCachePath[0] ? g_ProgramCachePath : 0;
+    }
+
     static void RepackLuminanceToRGBA(uint32_t num_pixels, uint8_t* luminance, uint8_t* rgba)
     {
         for(uint32_t px=0; px < num_pixels; px++)
@@ -249,10 +361,10 @@ namespace dmRive
         }
     }
 
-    rive::rcp<rive::RenderImage> CreateRiveRenderImage(HRenderContext context, void* bytes, uint32_t byte_count)
+    rive::rcp<rive::RenderImage> CreateRiveRenderImage(HRenderContext context, void* bytes, uint32_t byte_count, dmArray<uint8_t>* scratch)
     {
         dmImage::HImage img          = dmImage::NewImage(bytes, byte_count, false);
-        DefoldRiveRenderer* renderer = (DefoldRiveRenderer*) context;
+        DefoldRiveRenderer* renderer = ((RenderContext*) context)->m_Renderer;
 
         rive::rcp<rive::gpu::Texture> texture;
         if (img)
@@ -262,29 +374,23 @@ namespace dmRive
             uint32_t img_height = dmImage::GetHeight(img);
 
             uint8_t* bitmap_data_rgba = (uint8_t*) dmImage::GetData(img);
-            uint8_t* bitmap_data_tmp  = 0;
-
-            if (img_type == dmImage::TYPE_RGB)
-            {
-                bitmap_data_tmp = (uint8_t*) malloc(img_width * img_height * 4);
-
-                dmGraphics::RepackRGBToRGBA(img_width * img_height, bitmap_data_rgba, bitmap_data_tmp);
-
-                bitmap_data_rgba = bitmap_data_tmp;
-            }
-            else if (img_type == dmImage::TYPE_LUMINANCE)
-            {
-                bitmap_data_tmp = (uint8_t*) malloc(img_width * img_height * 4);
-
-                RepackLuminanceToRGBA(img_width * img_height, bitmap_data_rgba, bitmap_data_tmp);
 
-                bitmap_data_rgba = bitmap_data_tmp;
-            }
-            else if (img_type == dmImage::TYPE_LUMINANCE_ALPHA)
+            if (img_type == dmImage::TYPE_RGB || img_type == dmImage::TYPE_LUMINANCE || img_type == dmImage::TYPE_LUMINANCE_ALPHA)
             {
-                bitmap_data_tmp = (uint8_t*) malloc(img_width * img_height * 4);
+                uint32_t rgba_size = img_width * img_height * 4;
+                if (scratch->Capacity() < rgba_size)
+                {
+                    scratch->SetCapacity(rgba_size);
+                }
+                scratch->SetSize(rgba_size);
+                uint8_t* bitmap_data_tmp = scratch->Begin();
 
-                RepackLuminanceAlphaToRGBA(img_width * img_height, bitmap_data_rgba, bitmap_data_tmp);
+                if (img_type == dmImage::TYPE_RGB)
+                    dmGraphics::RepackRGBToRGBA(img_width * img_height, bitmap_data_rgba, bitmap_data_tmp);
+                else if (img_type == dmImage::TYPE_LUMINANCE)
+                    RepackLuminanceToRGBA(img_width * img_height, bitmap_data_rgba, bitmap_data_tmp);
+                else
+                    RepackLuminanceAlphaToRGBA(img_width * img_height, bitmap_data_rgba, bitmap_data_tmp);
 
                 bitmap_data_rgba = bitmap_data_tmp;
             }
@@ -292,11 +398,6 @@ namespace dmRive
             texture = renderer->m_RenderContext->MakeImageTexture(img_width, img_height, 0, (const uint8_t*) bitmap_data_rgba);
 
             dmImage::DeleteImage(img);
-
-            if (bitmap_data_tmp)
-            {
-                free(bitmap_data_tmp);
-            }
         }
         else
         {
@@ -321,7 +422,7 @@ namespace dmRive
 
     dmRender::HMaterial GetBlitToBackBufferMaterial(HRenderContext context, dmRender::HRenderContext render_context)
     {
-        DefoldRiveRenderer* renderer = (DefoldRiveRenderer*) context;
+        DefoldRiveRenderer* renderer = ((RenderContext*) context)->m_Renderer;
         if (!renderer->m_BlitMaterial)
         {
             renderer->m_BlitMaterial = dmRender::NewMaterial(render_context, renderer->m_BlitVs, renderer->m_BlitFs);
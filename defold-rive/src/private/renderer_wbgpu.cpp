@@ -13,6 +13,28 @@
 
 namespace dmRive
 {
+    class DefoldRiveRenderTargetWebGPU : public IDefoldRiveRenderTarget
+    {
+    public:
+        DefoldRiveRenderTargetWebGPU(rive::gpu::RenderContextWebGPUImpl* render_context_impl)
+        : m_RenderContextImpl(render_context_impl)
+        {
+        }
+
+        void OnSizeChanged(uint32_t width, uint32_t height, uint32_t sample_count) override
+        {
+            m_RenderTarget = m_RenderContextImpl->makeRenderTarget(wgpu::TextureFormat::BGRA8Unorm, width, height);
+        }
+
+        dmGraphics::HTexture GetBackingTexture() override
+        {
+            return 0; // m_BackingTexture;
+        }
+
+        rive::gpu::RenderContextWebGPUImpl*       m_RenderContextImpl;
+        rive::rcp<rive::gpu::RenderTargetWebGPU>  m_RenderTarget;
+    };
+
     class DefoldRiveRendererWebGPU : public IDefoldRiveRenderer
     {
     public:
@@ -41,15 +63,20 @@ namespace dmRive
             m_RenderContext->beginFrame(frameDescriptor);
         }
 
-        void Flush() override
+        void Flush(IDefoldRiveRenderTarget* target) override
         {
-            m_RenderContext->flush({.renderTarget = m_RenderTarget.get()});
+            m_RenderContext->flush({.renderTarget = ((DefoldRiveRenderTargetWebGPU*) target)->m_RenderTarget.get()});
         }
 
-        void OnSizeChanged(uint32_t width, uint32_t height, uint32_t sample_count) override
+        IDefoldRiveRenderTarget* NewRenderTarget() override
         {
             auto renderContextImpl = m_RenderContext->static_impl_cast<rive::gpu::RenderContextWebGPUImpl>();
-            m_RenderTarget         = renderContextImpl->makeRenderTarget(wgpu::TextureFormat::BGRA8Unorm, width, height);
+            return new DefoldRiveRenderTargetWebGPU(renderContextImpl);
+        }
+
+        void SetRestoreState(bool restore) override
+        {
+            // The pipeline state isn't shared with Defold
         }
 
         void SetGraphicsContext(dmGraphics::HContext graphics_context) override
@@ -70,11 +97,6 @@ namespace dmRive
             // m_TargetTexture = texture;
         }
 
-        dmGraphics::HTexture GetBackingTexture() override
-        {
-            return 0; // m_BackingTexture;
-        }
-
         rive::rcp<rive::gpu::Texture> MakeImageTexture(uint32_t width,
                                                       uint32_t height,
                                                       uint32_t mipLevelCount,
@@ -102,7 +124,6 @@ namespace dmRive
         // dmGraphics::HTexture                      m_TargetTexture;
 
         std::unique_ptr<rive::gpu::RenderContext> m_RenderContext;
-        rive::rcp<rive::gpu::RenderTargetWebGPU>  m_RenderTarget;
         dmGraphics::HContext                      m_GraphicsContext;
 
         WGPUDevice                                m_BackendDevice;
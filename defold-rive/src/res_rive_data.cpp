@@ -24,21 +24,125 @@
 #include <rive/animation/state_machine.hpp>
 
 #include "res_rive_data.h"
+#include "baked_animation.h"
+#include "comp_rive.h"
 #include <common/atlas.h>
 #include <common/factory.h>
 
 namespace dmRive
 {
-    static void SetupData(RiveSceneData* scene_data, rive::File* file, const char* path, HRenderContext rive_render_context)
+    // Rive doesn't expose the size of the runtime objects, and they vary a lot by type, so this is a rough
+    // average of a cloned core object (component, keyed data, render path etc). It isn't measured, and the
+    // totals should only be used to compare files and spot growth, not as the actual memory use
+    static const uint32_t ESTIMATED_CORE_OBJECT_SIZE = 160;
+
+    static uint32_t g_TextureBytes = 0;
+
+    uint32_t GetTextureBytes()
+    {
+        return g_TextureBytes;
+    }
+
+    uint32_t EstimateArtboardInstanceBytes(const rive::Artboard* artboard)
+    {
+        if (!artboard)
+            return 0;
+        return sizeof(rive::ArtboardInstance) + (uint32_t)artboard->objects().size() * ESTIMATED_CORE_OBJECT_SIZE;
+    }
+
+    static std::unique_ptr<rive::ArtboardInstance> CreateArtboardInstance(rive::File* file, const char* artboard_name)
+    {
+        if (artboard_name && artboard_name[0])
+            return file->artboardNamed(artboard_name);
+        return file->artboardDefault();
+    }
+
+    static BakedAnimation* GetOrBakeAnimation(RiveSceneData* scene_data, rive::ArtboardInstance* artboard, const rive::LinearAnimation* animation)
+    {
+        dmhash_t key = (dmhash_t)(uintptr_t)animation;
+        BakedAnimation** cached = scene_data->m_BakedAnimations.Get(key);
+        if (cached)
+        {
+            return *cached;
+        }
+
+        BakedAnimation* baked = BakeAnimation(artboard, animation);
+        if (scene_data->m_BakedAnimations.Full())
+        {
+            scene_data->m_BakedAnimations.OffsetCapacity(16);
+        }
+        scene_data->m_BakedAnimations.Put(key, baked);
+        return baked;
+    }
+
+    BakedAnimation* GetBakedAnimation(RiveSceneData* scene_data, const char* artboard_name, const rive::LinearAnimation* animation)
+    {
+        BakedAnimation** cached = scene_data->m_BakedAnimations.Get((dmhash_t)(uintptr_t)animation);
+        if (cached)
+        {
+            return *cached;
+        }
+
+        // Sample using a separate instance, as the sampling leaves the artboard in the last sampled state
+        std::unique_ptr<rive::ArtboardInstance> artboard = CreateArtboardInstance(scene_data->m_File, artboard_name);
+        if (!artboard)
+        {
+            return 0;
+        }
+        return GetOrBakeAnimation(scene_data, artboard.get(), animation);
+    }
+
+    void BakeAnimations(RiveSceneData* scene_data, const char* artboard_name)
+    {
+        std::unique_ptr<rive::ArtboardInstance> artboard = CreateArtboardInstance(scene_data->m_File, artboard_name);
+        if (!artboard)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < artboard->animationCount(); ++i)
+        {
+            GetOrBakeAnimation(scene_data, artboard.get(), artboard->animation(i));
+        }
+    }
+
+    static void DeleteBakedAnimationCallback(void*, const dmhash_t* key, BakedAnimation** baked)
+    {
+        if (*baked)
+        {
+            DeleteBakedAnimation(*baked);
+        }
+    }
+
+    static void DeleteBakedAnimations(RiveSceneData* scene_data)
+    {
+        scene_data->m_BakedAnimations.Iterate(DeleteBakedAnimationCallback, (void*)0);
+        scene_data->m_BakedAnimations.Clear();
+    }
+
+    static uint32_t GetResourceSize(RiveSceneData* scene_data, uint32_t buffer_size)
+    {
+        // The file graph is built from the buffer (strings and byte payloads are copied)
+        return sizeof(RiveSceneData) + buffer_size + scene_data->m_TextureBytes + scene_data->m_InstanceBytes;
+    }
+
+    static void SetupData(RiveSceneData* scene_data, rive::File* file, const char* path, HRenderContext rive_render_context, uint32_t texture_bytes)
     {
         scene_data->m_File = file;
         scene_data->m_RiveRenderContext = rive_render_context;
+        scene_data->m_TextureBytes = texture_bytes;
+        g_TextureBytes += texture_bytes;
+        scene_data->m_Prewarmed = 0;
 
         scene_data->m_ArtboardDefault = scene_data->m_File->artboardDefault();
         rive::Artboard* artboard = scene_data->m_ArtboardDefault.get();
+        scene_data->m_InstanceBytes = EstimateArtboardInstanceBytes(artboard);
         if (!artboard)
             return;
 
+        scene_data->m_LinearAnimations.SetSize(0);
+        scene_data->m_StateMachines.SetSize(0);
+
         uint32_t animation_count = (uint32_t)artboard->animationCount();
         if (animation_count > 0)
         {
@@ -94,17 +198,21 @@ namespace dmRive
 
         RiveSceneData* scene_data = new RiveSceneData();
 
-        SetupData(scene_data, file.release(), params->m_Filename, render_context_res);
+        SetupData(scene_data, file.release(), params->m_Filename, render_context_res, atlas_resolver.GetTextureBytes());
 
         dmResource::SetResource(params->m_Resource, scene_data);
-        dmResource::SetResourceSize(params->m_Resource, 0);
+        dmResource::SetResourceSize(params->m_Resource, GetResourceSize(scene_data, params->m_BufferSize));
 
         return dmResource::RESULT_OK;
     }
 
     static void DeleteData(RiveSceneData* scene_data)
     {
+        g_TextureBytes -= scene_data->m_TextureBytes;
+        DeleteBakedAnimations(scene_data);
+        scene_data->m_ArtboardDefault.reset();
         delete scene_data->m_File;
+        delete scene_data->m_RetiredFile;
         delete scene_data;
     }
 
@@ -136,19 +244,31 @@ namespace dmRive
             return dmResource::RESULT_INVALID_DATA;
         }
 
-        RiveSceneData* old_data = (RiveSceneData*)dmResource::GetResource(params->m_Resource);
-        if (old_data != 0)
+        // We update the data in place, since the scene resources and components are holding on to the pointer
+        RiveSceneData* scene_data = (RiveSceneData*)dmResource::GetResource(params->m_Resource);
+        if (scene_data == 0)
         {
-            dmResource::SetResource(params->m_Resource, 0);
-            DeleteData(old_data);
+            scene_data = new RiveSceneData();
+            dmResource::SetResource(params->m_Resource, scene_data);
+        }
+        else
+        {
+            // The components may be advanced on the worker threads, using the baked animations and the current file
+            CompRiveWaitForAdvances();
+
+            // The components still reference the current file until they're reinstanced
+            // in the resource reloaded callback, so we only delete the file from the previous reload
+            delete scene_data->m_RetiredFile;
+            // The animations of the new file are baked when they're first played, as the models aren't recreated on a reload
+            DeleteBakedAnimations(scene_data);
+            scene_data->m_ArtboardDefault.reset();
+            scene_data->m_RetiredFile = scene_data->m_File;
+            g_TextureBytes -= scene_data->m_TextureBytes;
         }
 
-        RiveSceneData* scene_data = new RiveSceneData();
-
-        SetupData(scene_data, file.release(), params->m_Filename, render_context_res);
+        SetupData(scene_data, file.release(), params->m_Filename, render_context_res, atlas_resolver.GetTextureBytes());
 
-        dmResource::SetResource(params->m_Resource, scene_data);
-        dmResource::SetResourceSize(params->m_Resource, 0);
+        dmResource::SetResourceSize(params->m_Resource, GetResourceSize(scene_data, params->m_BufferSize));
 
         return dmResource::RESULT_OK;
     }
@@ -16,25 +16,45 @@
 #include <stdint.h>
 #include <dmsdk/dlib/array.h>
 #include <dmsdk/dlib/hash.h>
+#include <dmsdk/dlib/hashtable.h>
 #include "renderer.h"
 
 namespace rive
 {
+	class Artboard;
 	class File;
+	class LinearAnimation;
 }
 
 namespace dmRive
 {
 	struct RiveBone;
+	struct BakedAnimation;
 
 	struct RiveSceneData
 	{
 		rive::File* 							m_File;
+		rive::File* 							m_RetiredFile;   // The previous file, kept alive until the components have been reinstanced after a reload
 		HRenderContext                          m_RiveRenderContext;
 		std::unique_ptr<rive::ArtboardInstance> m_ArtboardDefault;
 	    dmArray<dmhash_t> 						m_LinearAnimations;
 	    dmArray<dmhash_t> 						m_StateMachines;
+	    uint32_t                                m_TextureBytes;  // GPU memory used by the images of the file
+	    uint32_t                                m_InstanceBytes; // Estimated memory used by m_ArtboardDefault
+	    dmHashTable64<BakedAnimation*>          m_BakedAnimations; // Baked animations of m_File, by animation. Null if the animation can't be baked
+	    uint8_t                                 m_Prewarmed : 1; // The GPU programs used by m_File have been compiled
 	};
+
+	// Total number of bytes used by the textures of all loaded rive files
+	uint32_t GetTextureBytes();
+	// Estimated number of bytes used by an artboard instance, from its number of objects. Not measured
+	uint32_t EstimateArtboardInstanceBytes(const rive::Artboard* artboard);
+
+	// Get the baked version of an animation in the artboard (empty name for the default artboard), baking it the first time.
+	// Returns 0 if the animation can't be baked
+	BakedAnimation* GetBakedAnimation(RiveSceneData* scene_data, const char* artboard_name, const rive::LinearAnimation* animation);
+	// Bakes all the animations in the artboard
+	void BakeAnimations(RiveSceneData* scene_data, const char* artboard_name);
 }
 
 #endif // DM_RES_RIVE_DATA_H
@@ -13,6 +13,8 @@
 #if !defined(DM_RIVE_UNSUPPORTED)
 
 #include "res_rive_model.h"
+#include "res_rive_scene.h"
+#include "res_rive_data.h"
 
 #include <dmsdk/dlib/log.h>
 #include <dmsdk/resource/resource.h>
@@ -33,6 +35,14 @@ namespace dmRive
             return result;
         }
         resource->m_CreateGoBones = resource->m_DDF->m_CreateGoBones;
+        resource->m_BakeAnimations = resource->m_DDF->m_BakeAnimations;
+
+        // Bake up front, to avoid doing it when the animations are played
+        RiveSceneData* scene_data = (RiveSceneData*)resource->m_Scene->m_Scene;
+        if (resource->m_BakeAnimations && scene_data)
+        {
+            BakeAnimations(scene_data, resource->m_DDF->m_Artboard);
+        }
         return dmResource::RESULT_OK;
     }
 
@@ -26,7 +26,8 @@ namespace dmRive
         struct RiveSceneResource*       m_Scene;
         dmGameSystem::MaterialResource* m_Material;
         uint8_t                         m_CreateGoBones:1;
-        uint8_t                         :7;
+        uint8_t                         m_BakeAnimations:1;
+        uint8_t                         :6;
     };
 }
 
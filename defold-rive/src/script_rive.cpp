@@ -16,9 +16,22 @@
 #include <rive/animation/linear_animation_instance.hpp>
 #include <rive/animation/state_machine.hpp>
 #include <rive/animation/state_machine_instance.hpp>
+#include <rive/viewmodel/viewmodel_instance.hpp>
+#include <rive/viewmodel/viewmodel_instance_boolean.hpp>
+#include <rive/viewmodel/viewmodel_instance_color.hpp>
+#include <rive/viewmodel/viewmodel_instance_enum.hpp>
+#include <rive/viewmodel/viewmodel_instance_list.hpp>
+#include <rive/viewmodel/viewmodel_instance_number.hpp>
+#include <rive/viewmodel/viewmodel_instance_string.hpp>
+#include <rive/viewmodel/viewmodel_instance_trigger.hpp>
+#include <rive/viewmodel/viewmodel_instance_viewmodel.hpp>
+#include <rive/viewmodel/viewmodel_property_enum.hpp>
+#include <rive/viewmodel/data_enum.hpp>
 
 #include <dmsdk/sdk.h>
+#include <dmsdk/dlib/dstrings.h>
 #include <dmsdk/dlib/hash.h>
+#include <dmsdk/dlib/math.h>
 #include <dmsdk/dlib/message.h>
 #include <dmsdk/gameobject/script.h>
 #include <dmsdk/gamesys/script.h>
@@ -59,6 +72,7 @@ namespace dmRive
         ddf.m_Offset            = 0.0;
         ddf.m_PlaybackRate      = 1.0;
         ddf.m_IsStateMachine    = false;
+        ddf.m_CrossfadeTime     = 0.0f;
 
         if (top > 3) // table with args
         {
@@ -75,6 +89,10 @@ namespace dmRive
                 ddf.m_PlaybackRate = lua_isnil(L, -1) ? 1.0 : luaL_checknumber(L, -1);
                 lua_pop(L, 1);
 
+                lua_getfield(L, -1, "crossfade_time");
+                ddf.m_CrossfadeTime = lua_isnil(L, -1) ? 0.0 : luaL_checknumber(L, -1);
+                lua_pop(L, 1);
+
                 lua_pop(L, 1);
             }
         }
@@ -117,6 +135,7 @@ namespace dmRive
         ddf.m_Offset            = 0.0;
         ddf.m_PlaybackRate      = 1.0;
         ddf.m_IsStateMachine    = true;
+        ddf.m_CrossfadeTime     = 0.0f;
 
         if (top > 2) // table with args
         {
@@ -214,6 +233,471 @@ namespace dmRive
         return 1;
     }
 
+    /*# get the world transform of a rive artboard bone
+     * Returns the world position and rotation of a bone, read directly from the artboard.
+     * Unlike [ref:rive.get_go], this doesn't require the rive model to create a game object per bone.
+     * The transform is from the last update of the rive model.
+     *
+     * @name rive.get_bone_transform
+     * @param url [type:string|hash|url] the rive model to query
+     * @param bone_id [type:string|hash] id of the bone
+     * @return position [type:vector3] the world position of the bone
+     * @return rotation [type:quaternion] the world rotation of the bone
+     * @examples
+     *
+     * ```lua
+     * local position, rotation = rive.get_bone_transform("#rivemodel", "right_hand")
+     * ```
+     */
+    static int RiveComp_GetBoneTransform(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 2);
+
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
+
+        dmhash_t bone_name = dmScript::CheckHashOrString(L, 2);
+
+        dmVMath::Point3 position;
+        dmVMath::Quat rotation;
+        if (!CompRiveGetBoneTransform(component, bone_name, &position, &rotation)) {
+            return DM_LUA_ERROR("the bone '%s' could not be found", dmHashReverseSafe64(bone_name));
+        }
+
+        dmScript::PushVector3(L, dmVMath::Vector3(position));
+        dmScript::PushQuat(L, rotation);
+        return 2;
+    }
+
+    /*# make a game object follow a rive artboard bone
+     * Makes a game object follow a bone of a rive model. The position and rotation of the game object
+     * are set from the bone each frame, after the rive model has been updated. Only the attached bones
+     * are updated, which makes this cheaper than creating a game object per bone.
+     * The game object must be in the same collection as the rive model. It is detached when it's deleted.
+     *
+     * @name rive.attach_to_bone
+     * @param url [type:string|hash|url] the rive model
+     * @param bone_id [type:string|hash] id of the bone
+     * @param instance [type:string|hash|url] the game object to attach
+     * @examples
+     *
+     * ```lua
+     * function init(self)
+     *   rive.attach_to_bone("player#rivemodel", "right_hand", "pistol")
+     * end
+     * ```
+     */
+    static int RiveComp_AttachToBone(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
+
+        dmhash_t bone_name = dmScript::CheckHashOrString(L, 2);
+        dmGameObject::HInstance instance = dmScript::CheckGOInstance(L, 3);
+
+        if (dmGameObject::GetCollection(instance) != dmGameObject::GetCollection(component->m_Instance)) {
+            return DM_LUA_ERROR("the game object must be in the same collection as the rive model");
+        }
+
+        if (!CompRiveAttachToBone(component, bone_name, dmGameObject::GetIdentifier(instance))) {
+            return DM_LUA_ERROR("the bone '%s' could not be found", dmHashReverseSafe64(bone_name));
+        }
+        return 0;
+    }
+
+    /*# stop a game object from following a rive artboard bone
+     * Detaches a game object previously attached using [ref:rive.attach_to_bone]. The game object keeps its current transform.
+     *
+     * @name rive.detach_from_bone
+     * @param url [type:string|hash|url] the rive model
+     * @param instance [type:string|hash|url] the game object to detach
+     */
+    static int RiveComp_DetachFromBone(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
+
+        dmGameObject::HInstance instance = dmScript::CheckGOInstance(L, 2);
+        CompRiveDetachFromBone(component, dmGameObject::GetIdentifier(instance));
+        return 0;
+    }
+
+    /*# set the text of a text run
+     * Sets the text of a named text run in the artboard of a rive model.
+     * Setting the same text as the text run already has is cheap, which makes it
+     * ok to update texts such as counters and timers every frame.
+     *
+     * @name rive.set_text
+     * @param url [type:string|hash|url] the rive model
+     * @param run_id [type:string|hash] name of the text run
+     * @param text [type:string] the new text
+     * @examples
+     *
+     * ```lua
+     * function update(self, dt)
+     *   rive.set_text("#rivemodel", "score", tostring(self.score))
+     * end
+     * ```
+     */
+    static int RiveComp_SetText(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
+
+        dmhash_t run_name = dmScript::CheckHashOrString(L, 2);
+        const char* text = luaL_checkstring(L, 3);
+
+        if (!CompRiveSetTextRun(component, run_name, text)) {
+            return DM_LUA_ERROR("the text run '%s' could not be found", dmHashReverseSafe64(run_name));
+        }
+
+        return 0;
+    }
+
+    static bool SetViewModelProperties(lua_State* L, RiveComponent* component, rive::ViewModelInstance* instance, int table_index, bool apply, char* error, uint32_t error_size);
+
+    // Applies the items of the table at table_index to the existing items in the list. See SetViewModelProperties()
+    static bool SetViewModelListItems(lua_State* L, RiveComponent* component, rive::ViewModelInstanceList* list, int table_index, bool apply, char* error, uint32_t error_size)
+    {
+        uint32_t count = (uint32_t)lua_objlen(L, table_index);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            lua_rawgeti(L, table_index, i + 1);
+            if (lua_istable(L, -1))
+            {
+                rive::ViewModelInstanceListItem* item = list->item(i);
+                if (!item || !item->viewModelInstance())
+                {
+                    dmSnPrintf(error, error_size, "the list item %d could not be found", i + 1);
+                    lua_pop(L, 1);
+                    return false;
+                }
+                if (!SetViewModelProperties(L, component, item->viewModelInstance(), lua_gettop(L), apply, error, error_size))
+                {
+                    lua_pop(L, 1);
+                    return false;
+                }
+            }
+            lua_pop(L, 1);
+        }
+        return true;
+    }
+
+    static bool IsColor(lua_State* L, int index)
+    {
+        return dmScript::ToVector4(L, index) != 0 || lua_isnumber(L, index);
+    }
+
+    static int ToColor(lua_State* L, int index)
+    {
+        dmVMath::Vector4* v = dmScript::ToVector4(L, index);
+        if (v)
+        {
+            uint32_t r = (uint32_t)(dmMath::Clamp(v->getX(), 0.0f, 1.0f) * 255.0f);
+            uint32_t g = (uint32_t)(dmMath::Clamp(v->getY(), 0.0f, 1.0f) * 255.0f);
+            uint32_t b = (uint32_t)(dmMath::Clamp(v->getZ(), 0.0f, 1.0f) * 255.0f);
+            uint32_t a = (uint32_t)(dmMath::Clamp(v->getW(), 0.0f, 1.0f) * 255.0f);
+            return (int)((a << 24) | (r << 16) | (g << 8) | b);
+        }
+        // 0xAARRGGBB
+        return (int)(uint32_t)lua_tonumber(L, index);
+    }
+
+    static bool IsEnumValue(lua_State* L, int index, rive::ViewModelInstanceEnum* property)
+    {
+        rive::ViewModelPropertyEnum* enum_property = property->viewModelProperty() ? property->viewModelProperty()->as<rive::ViewModelPropertyEnum>() : 0;
+        rive::DataEnum* data_enum = enum_property ? enum_property->dataEnum() : 0;
+        if (!data_enum)
+        {
+            return false;
+        }
+        if (lua_type(L, index) == LUA_TNUMBER)
+        {
+            return lua_tonumber(L, index) >= 0 && (size_t)lua_tonumber(L, index) < data_enum->values().size();
+        }
+        return lua_isstring(L, index) && data_enum->valueIndex(std::string(lua_tostring(L, index))) >= 0;
+    }
+
+    // Sets the properties from the table at table_index. Only values that differ from the current ones are written,
+    // so that only the data binds depending on them are updated.
+    // With apply set to false, the properties are only checked, and the reason is written to error if any of them can't be set.
+    // Lua errors aren't raised here, so that the caller can report them through DM_LUA_ERROR after the whole table
+    // has been checked, and nothing is set from a table with an error
+    static bool SetViewModelProperties(lua_State* L, RiveComponent* component, rive::ViewModelInstance* instance, int table_index, bool apply, char* error, uint32_t error_size)
+    {
+        lua_pushnil(L);
+        while (lua_next(L, table_index) != 0)
+        {
+            // key at -2, value at -1
+            if (lua_type(L, -2) != LUA_TSTRING)
+            {
+                dmSnPrintf(error, error_size, "view model property names must be strings");
+                lua_pop(L, 2);
+                return false;
+            }
+            const char* name = lua_tostring(L, -2);
+
+            bool valid = true;
+            rive::ViewModelInstanceValue* value = CompRiveGetViewModelProperty(component, instance, name);
+            if (!value)
+            {
+                dmSnPrintf(error, error_size, "the view model property '%s' could not be found", name);
+                valid = false;
+            }
+            else if (value->is<rive::ViewModelInstanceNumber>())
+            {
+                valid = lua_isnumber(L, -1);
+                if (valid && apply)
+                    value->as<rive::ViewModelInstanceNumber>()->propertyValue((float)lua_tonumber(L, -1));
+            }
+            else if (value->is<rive::ViewModelInstanceString>())
+            {
+                valid = lua_isstring(L, -1);
+                if (valid && apply)
+                {
+                    size_t length;
+                    const char* text = lua_tolstring(L, -1, &length);
+                    rive::ViewModelInstanceString* property = value->as<rive::ViewModelInstanceString>();
+                    const std::string& current = property->propertyValue();
+                    if (current.size() != length || memcmp(current.c_str(), text, length) != 0)
+                    {
+                        property->propertyValue(std::string(text, length));
+                    }
+                }
+            }
+            else if (value->is<rive::ViewModelInstanceBoolean>())
+            {
+                valid = lua_isboolean(L, -1);
+                if (valid && apply)
+                    value->as<rive::ViewModelInstanceBoolean>()->propertyValue(lua_toboolean(L, -1) != 0);
+            }
+            else if (value->is<rive::ViewModelInstanceColor>())
+            {
+                valid = IsColor(L, -1);
+                if (valid && apply)
+                    value->as<rive::ViewModelInstanceColor>()->propertyValue(ToColor(L, -1));
+            }
+            else if (value->is<rive::ViewModelInstanceEnum>())
+            {
+                rive::ViewModelInstanceEnum* property = value->as<rive::ViewModelInstanceEnum>();
+                if (!IsEnumValue(L, -1, property))
+                {
+                    dmSnPrintf(error, error_size, "the enum value for '%s' could not be found", name);
+                    lua_pop(L, 2);
+                    return false;
+                }
+                if (apply)
+                {
+                    if (lua_type(L, -1) == LUA_TNUMBER)
+                        property->value((uint32_t)lua_tonumber(L, -1));
+                    else
+                        property->value(std::string(lua_tostring(L, -1)));
+                }
+            }
+            else if (value->is<rive::ViewModelInstanceTrigger>())
+            {
+                if (apply && lua_toboolean(L, -1))
+                {
+                    rive::ViewModelInstanceTrigger* property = value->as<rive::ViewModelInstanceTrigger>();
+                    property->propertyValue(property->propertyValue() + 1);
+                }
+            }
+            else if (value->is<rive::ViewModelInstanceViewModel>())
+            {
+                valid = lua_istable(L, -1);
+                rive::ViewModelInstance* reference = value->as<rive::ViewModelInstanceViewModel>()->referenceViewModelInstance();
+                if (valid && reference && !SetViewModelProperties(L, component, reference, lua_gettop(L), apply, error, error_size))
+                {
+                    lua_pop(L, 2);
+                    return false;
+                }
+            }
+            else if (value->is<rive::ViewModelInstanceList>())
+            {
+                valid = lua_istable(L, -1);
+                if (valid && !SetViewModelListItems(L, component, value->as<rive::ViewModelInstanceList>(), lua_gettop(L), apply, error, error_size))
+                {
+                    lua_pop(L, 2);
+                    return false;
+                }
+            }
+            else
+            {
+                dmSnPrintf(error, error_size, "the view model property '%s' has an unsupported type", name);
+                lua_pop(L, 2);
+                return false;
+            }
+
+            if (!valid)
+            {
+                if (value)
+                    dmSnPrintf(error, error_size, "the view model property '%s' can't be set from a %s", name, luaL_typename(L, -1));
+                lua_pop(L, 2);
+                return false;
+            }
+
+            lua_pop(L, 1);
+        }
+        return true;
+    }
+
+    /*# set view model properties
+     * Sets multiple properties of the view model instance bound to the artboard of a rive model.
+     * Only the properties with a changed value are updated, which makes it ok to set all the
+     * properties of e.g. a HUD every frame.
+     *
+     * Numbers, strings and booleans are set from the corresponding lua types.
+     * Colors are set from a `vector4` or a `0xAARRGGBB` number.
+     * Enums are set from the name or the index of the value.
+     * Triggers are fired by setting them to `true`.
+     * Nested view models are set from a table, and the existing items of a list from a list of tables.
+     *
+     * @name rive.set_properties
+     * @param url [type:string|hash|url] the rive model
+     * @param properties [type:table] the properties to set
+     * @examples
+     *
+     * ```lua
+     * function update(self, dt)
+     *   rive.set_properties("#rivemodel", {
+     *     score = self.score,
+     *     name = self.name,
+     *     player = { health = self.health, tint = vmath.vector4(1, 0, 0, 1) },
+     *     level_up = self.leveled_up,
+     *   })
+     * end
+     * ```
+     */
+    static int RiveComp_SetProperties(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
+        if (!lua_istable(L, 2))
+        {
+            return DM_LUA_ERROR("the properties must be a table");
+        }
+
+        if (!component->m_ViewModelInstance)
+        {
+            return DM_LUA_ERROR("the artboard has no view model");
+        }
+
+        char error[256];
+        if (!SetViewModelProperties(L, component, component->m_ViewModelInstance.get(), 2, false, error, sizeof(error)))
+        {
+            return DM_LUA_ERROR("%s", error);
+        }
+        SetViewModelProperties(L, component, component->m_ViewModelInstance.get(), 2, true, error, sizeof(error));
+        return 0;
+    }
+
+    /*# compile the GPU programs used by a rive model
+     * The first time a rive file draws a new combination of features (e.g. a blend mode, clipping,
+     * a gradient or an image mesh), the renderer has to compile a GPU program, which can cause a hitch.
+     * This draws all the artboards, animations and state machines of the file of the rive model offscreen,
+     * so that the programs are compiled up front, e.g. while a loading screen is shown.
+     * Only the first call per file does any work.
+     *
+     * @name rive.prewarm
+     * @param url [type:string|hash|url] the rive model
+     * @examples
+     *
+     * ```lua
+     * function init(self)
+     *   rive.prewarm("#rivemodel")
+     * end
+     * ```
+     */
+    static int RiveComp_Prewarm(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
+
+        CompRivePrewarm(component);
+        return 0;
+    }
+
+    /*# set the time scale of the rive models in a collection
+     * Scales the time for all rive models in the same collection as the specified rive model,
+     * on top of their individual playback rates. A time scale of 0 pauses the models, without any
+     * update cost.
+     *
+     * @name rive.set_time_scale
+     * @param url [type:string|hash|url] any rive model in the collection
+     * @param time_scale [type:number] the time scale. Must be >= 0.
+     * @examples
+     *
+     * ```lua
+     * function on_message(self, message_id, message, sender)
+     *   if message_id == hash("pause") then
+     *     rive.set_time_scale("#rivemodel", 0)
+     *   end
+     * end
+     * ```
+     */
+    static int RiveComp_SetTimeScale(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        RiveWorld* world = 0;
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, (void**)&world, (void**)&component, 0);
+
+        lua_Number time_scale = luaL_checknumber(L, 2);
+        if (time_scale < 0) {
+            return DM_LUA_ERROR("the time scale must be >= 0");
+        }
+
+        CompRiveSetTimeScale(world, time_scale);
+        return 0;
+    }
+
+    /*# set the fixed timestep of the rive models in a collection
+     * Makes all rive models in the same collection as the specified rive model advance in
+     * fixed time steps, which makes the animations and state machines deterministic regardless
+     * of the frame rate. The frame time is accumulated, and the models are advanced by as many
+     * whole steps as fit, up to `max_substeps` steps per frame.
+     *
+     * @name rive.set_fixed_timestep
+     * @param url [type:string|hash|url] any rive model in the collection
+     * @param step [type:number] the timestep in seconds. Use 0 to advance using the frame time.
+     * @param [max_substeps] [type:number] max number of steps per frame. Defaults to 4.
+     * @examples
+     *
+     * ```lua
+     * function init(self)
+     *   rive.set_fixed_timestep("#rivemodel", 1/60, 4)
+     * end
+     * ```
+     */
+    static int RiveComp_SetFixedTimestep(lua_State* L)
+    {
+        DM_LUA_STACK_CHECK(L, 0);
+
+        RiveWorld* world = 0;
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, (void**)&world, (void**)&component, 0);
+
+        lua_Number step = luaL_checknumber(L, 2);
+        lua_Number max_substeps = luaL_optnumber(L, 3, 4);
+        if (step < 0 || max_substeps < 1) {
+            return DM_LUA_ERROR("the timestep must be >= 0 and max_substeps must be >= 1");
+        }
+
+        CompRiveSetFixedTimestep(world, step, (uint32_t)max_substeps);
+        return 0;
+    }
+
     static int RiveComp_PointerMove(lua_State* L)
     {
         DM_LUA_STACK_CHECK(L, 0);
@@ -222,8 +706,9 @@ namespace dmRive
         dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
         lua_Number x = luaL_checknumber(L, 2);
         lua_Number y = luaL_checknumber(L, 3);
+        uint32_t pointer_id = (uint32_t)luaL_optinteger(L, 4, 0);
 
-        CompRivePointerMove(component, x, y);
+        CompRivePointerMove(component, x, y, pointer_id);
 
         return 0;
     }
@@ -236,8 +721,9 @@ namespace dmRive
         dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
         lua_Number x = luaL_checknumber(L, 2);
         lua_Number y = luaL_checknumber(L, 3);
+        uint32_t pointer_id = (uint32_t)luaL_optinteger(L, 4, 0);
 
-        CompRivePointerUp(component, x, y);
+        CompRivePointerUp(component, x, y, pointer_id);
 
         return 0;
     }
@@ -250,12 +736,79 @@ namespace dmRive
         dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, 0, (void**)&component, 0);
         lua_Number x = luaL_checknumber(L, 2);
         lua_Number y = luaL_checknumber(L, 3);
+        uint32_t pointer_id = (uint32_t)luaL_optinteger(L, 4, 0);
 
-        CompRivePointerDown(component, x, y);
+        CompRivePointerDown(component, x, y, pointer_id);
 
         return 0;
     }
 
+    static int WorldPointerEvent(lua_State* L, PointerEventType type)
+    {
+        DM_LUA_STACK_CHECK(L, 1);
+
+        RiveWorld* world = 0;
+        RiveComponent* component = 0;
+        dmScript::GetComponentFromLua(L, 1, dmRive::RIVE_MODEL_EXT, (void**)&world, (void**)&component, 0);
+        lua_Number x = luaL_checknumber(L, 2);
+        lua_Number y = luaL_checknumber(L, 3);
+
+        lua_pushboolean(L, CompRiveWorldPointerEvent(world, type, x, y));
+        return 1;
+    }
+
+    /*# forward a pointer move to the rive models under the pointer
+     * Forwards a pointer move to the state machines of all rive models in the collection that are under the pointer.
+     * Unlike [ref:rive.pointer_move], the rive models don't have to be tested one by one from script.
+     * Rive models that the pointer has left receive a pointer exit.
+     *
+     * @name rive.world_pointer_move
+     * @param url [type:string|hash|url] any rive model in the collection
+     * @param x [type:number] horizontal position
+     * @param y [type:number] vertical position
+     * @return hit [type:boolean] true if a listener was hit
+     * @examples
+     *
+     * ```lua
+     * function on_input(self, action_id, action)
+     *   if action_id == nil then
+     *     rive.world_pointer_move("#rivemodel", action.x, action.y)
+     *   end
+     * end
+     * ```
+     */
+    static int RiveComp_WorldPointerMove(lua_State* L)
+    {
+        return WorldPointerEvent(L, POINTER_EVENT_MOVE);
+    }
+
+    /*# forward a pointer release to the rive models under the pointer
+     * Forwards a pointer release to the state machines of all rive models in the collection that are under the pointer.
+     *
+     * @name rive.world_pointer_up
+     * @param url [type:string|hash|url] any rive model in the collection
+     * @param x [type:number] horizontal position
+     * @param y [type:number] vertical position
+     * @return hit [type:boolean] true if a listener was hit
+     */
+    static int RiveComp_WorldPointerUp(lua_State* L)
+    {
+        return WorldPointerEvent(L, POINTER_EVENT_UP);
+    }
+
+    /*# forward a pointer press to the rive models under the pointer
+     * Forwards a pointer press to the state machines of all rive models in the collection that are under the pointer.
+     *
+     * @name rive.world_pointer_down
+     * @param url [type:string|hash|url] any rive model in the collection
+     * @param x [type:number] horizontal position
+     * @param y [type:number] vertical position
+     * @return hit [type:boolean] true if a listener was hit
+     */
+    static int RiveComp_WorldPointerDown(lua_State* L)
+    {
+        return WorldPointerEvent(L, POINTER_EVENT_DOWN);
+    }
 
     static const luaL_reg RIVE_FUNCTIONS[] =
     {
@@ -263,9 +816,20 @@ namespace dmRive
         {"play_state_machine",  RiveComp_PlayStateMachine},
         {"cancel",              RiveComp_Cancel},
         {"get_go",              RiveComp_GetGO},
+        {"get_bone_transform",  RiveComp_GetBoneTransform},
+        {"attach_to_bone",      RiveComp_AttachToBone},
+        {"detach_from_bone",    RiveComp_DetachFromBone},
+        {"set_text",            RiveComp_SetText},
+        {"set_properties",      RiveComp_SetProperties},
+        {"set_fixed_timestep",  RiveComp_SetFixedTimestep},
+        {"set_time_scale",      RiveComp_SetTimeScale},
+        {"prewarm",             RiveComp_Prewarm},
         {"pointer_move",        RiveComp_PointerMove},
         {"pointer_up",          RiveComp_PointerUp},
         {"pointer_down",        RiveComp_PointerDown},
+        {"world_pointer_move",  RiveComp_WorldPointerMove},
+        {"world_pointer_up",    RiveComp_WorldPointerUp},
+        {"world_pointer_down",  RiveComp_WorldPointerDown},
         {0, 0}
     };
 
@@ -0,0 +1,177 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "worker_pool.h"
+
+#include <dmsdk/dlib/array.h>
+#include <dmsdk/dlib/condition_variable.h>
+#include <dmsdk/dlib/mutex.h>
+#include <dmsdk/dlib/thread.h>
+
+namespace dmRive
+{
+    struct WorkerPool
+    {
+        dmArray<dmThread::Thread>               m_Threads;
+        dmArray<WorkerJob*>                     m_Queue;    // Jobs with items left to start, oldest first
+        dmMutex::HMutex                         m_Mutex;
+        dmConditionVariable::HConditionVariable m_WorkAvailable;
+        dmConditionVariable::HConditionVariable m_WorkDone;
+        bool                                    m_Quit;
+    };
+
+    // Called with the mutex held. Returns false if the job has no items left to start
+    static bool TakeItem(WorkerPool* pool, WorkerJob* job, uint32_t* index)
+    {
+        if (job->m_Next >= job->m_Count)
+            return false;
+
+        *index = job->m_Next++;
+        if (job->m_Next == job->m_Count && pool)
+        {
+            // Keep the order of the queue, so that the oldest job is finished first
+            uint32_t size = pool->m_Queue.Size();
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                if (pool->m_Queue[i] == job)
+                {
+                    for (uint32_t j = i + 1; j < size; ++j)
+                        pool->m_Queue[j - 1] = pool->m_Queue[j];
+                    pool->m_Queue.SetSize(size - 1);
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Called with the mutex held. Runs the item with the mutex released
+    static void RunItem(WorkerPool* pool, WorkerJob* job, uint32_t index)
+    {
+        dmMutex::Unlock(pool->m_Mutex);
+        job->m_Fn(job->m_Context, index);
+        dmMutex::Lock(pool->m_Mutex);
+
+        if (++job->m_Done == job->m_Count)
+        {
+            dmConditionVariable::Broadcast(pool->m_WorkDone);
+        }
+    }
+
+    static void WorkerThread(void* _pool)
+    {
+        WorkerPool* pool = (WorkerPool*)_pool;
+
+        dmMutex::Lock(pool->m_Mutex);
+        while (true)
+        {
+            while (!pool->m_Quit && pool->m_Queue.Empty())
+            {
+                dmConditionVariable::Wait(pool->m_WorkAvailable, pool->m_Mutex);
+            }
+            if (pool->m_Quit)
+                break;
+
+            WorkerJob* job = pool->m_Queue[0];
+            uint32_t index;
+            if (TakeItem(pool, job, &index))
+            {
+                RunItem(pool, job, index);
+            }
+        }
+        dmMutex::Unlock(pool->m_Mutex);
+    }
+
+    HWorkerPool NewWorkerPool(uint32_t thread_count)
+    {
+        if (thread_count == 0)
+            return 0;
+
+        WorkerPool* pool = new WorkerPool;
+        pool->m_Mutex         = dmMutex::New();
+        pool->m_WorkAvailable = dmConditionVariable::New();
+        pool->m_WorkDone      = dmConditionVariable::New();
+        pool->m_Quit          = false;
+        pool->m_Queue.SetCapacity(16);
+
+        pool->m_Threads.SetCapacity(thread_count);
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            pool->m_Threads.Push(dmThread::New(WorkerThread, 0x80000, pool, "rive_worker"));
+        }
+        return pool;
+    }
+
+    void DeleteWorkerPool(HWorkerPool pool)
+    {
+        if (!pool)
+            return;
+
+        dmMutex::Lock(pool->m_Mutex);
+        pool->m_Quit = true;
+        dmConditionVariable::Broadcast(pool->m_WorkAvailable);
+        dmMutex::Unlock(pool->m_Mutex);
+
+        for (uint32_t i = 0; i < pool->m_Threads.Size(); ++i)
+        {
+            dmThread::Join(pool->m_Threads[i]);
+        }
+
+        dmConditionVariable::Delete(pool->m_WorkAvailable);
+        dmConditionVariable::Delete(pool->m_WorkDone);
+        dmMutex::Delete(pool->m_Mutex);
+        delete pool;
+    }
+
+    void WorkerPoolStart(HWorkerPool pool, WorkerJob* job, WorkerJobFn fn, void* context, uint32_t count)
+    {
+        job->m_Fn      = fn;
+        job->m_Context = context;
+        job->m_Count   = count;
+        job->m_Next    = 0;
+        job->m_Done    = 0;
+
+        if (!pool || count == 0)
+            return;
+
+        DM_MUTEX_SCOPED_LOCK(pool->m_Mutex);
+        if (pool->m_Queue.Full())
+            pool->m_Queue.OffsetCapacity(16);
+        pool->m_Queue.Push(job);
+        dmConditionVariable::Broadcast(pool->m_WorkAvailable);
+    }
+
+    void WorkerPoolWait(HWorkerPool pool, WorkerJob* job)
+    {
+        uint32_t index;
+        if (!pool)
+        {
+            while (TakeItem(0, job, &index))
+            {
+                job->m_Fn(job->m_Context, index);
+                job->m_Done++;
+            }
+            return;
+        }
+
+        dmMutex::Lock(pool->m_Mutex);
+        while (TakeItem(pool, job, &index))
+        {
+            RunItem(pool, job, index);
+        }
+        while (job->m_Done < job->m_Count)
+        {
+            dmConditionVariable::Wait(pool->m_WorkDone, pool->m_Mutex);
+        }
+        dmMutex::Unlock(pool->m_Mutex);
+    }
+}
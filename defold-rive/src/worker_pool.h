@@ -0,0 +1,45 @@
+// Copyright 2020 The Defold Foundation
+// Licensed under the Defold License version 1.0 (the "License"); you may not use
+// this file except in compliance with the License.
+//
+// You may obtain a copy of the License, together with FAQs at
+// https://www.defold.com/license
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef DM_RIVE_WORKER_POOL_H
+#define DM_RIVE_WORKER_POOL_H
+
+#include <stdint.h>
+
+namespace dmRive
+{
+    typedef struct WorkerPool* HWorkerPool;
+
+    typedef void (*WorkerJobFn)(void* context, uint32_t index);
+
+    // Calls m_Fn(m_Context, i) for each i in [0, m_Count).
+    // Owned by the caller, and must stay alive until WorkerPoolWait() has returned
+    struct WorkerJob
+    {
+        WorkerJobFn m_Fn;
+        void*       m_Context;
+        uint32_t    m_Count;
+        uint32_t    m_Next;     // The next item to run
+        uint32_t    m_Done;     // Number of finished items
+    };
+
+    // With a thread count of 0, the jobs are run by WorkerPoolWait() on the calling thread
+    HWorkerPool NewWorkerPool(uint32_t thread_count);
+    void        DeleteWorkerPool(HWorkerPool pool);
+
+    // Queues the job. The pool may be 0
+    void        WorkerPoolStart(HWorkerPool pool, WorkerJob* job, WorkerJobFn fn, void* context, uint32_t count);
+    // Runs the items not yet started on the calling thread, and waits for the rest to finish
+    void        WorkerPoolWait(HWorkerPool pool, WorkerJob* job);
+}
+
+#endif // DM_RIVE_WORKER_POOL_H